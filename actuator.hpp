@@ -8,8 +8,8 @@
 #pragma once
 
 #include <vector>
-#include <list>
 #include <map>
+#include <iterator>
 #include <utility>
 #include <functional>
 #include <memory>
@@ -17,6 +17,49 @@
 #include <type_traits>
 #include <cassert>
 #include <exception>
+#include <algorithm>
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <chrono>
+#include <string_view>
+#include <tuple>
+#include <initializer_list>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#ifdef UNTANGLE_TRACE
+#include "actuator_trace.hpp"
+/**
+ * @brief Trace the enclosing scope, see actuator_trace.hpp.
+ */
+#define UNTANGLE_TRACE_SCOPE(actuator, action, name, length) \
+  const ::untangle::trace::scope untangle_trace_scope(actuator, action, name, length)
+#else
+#define UNTANGLE_TRACE_SCOPE(actuator, action, name, length) ((void)0)
+#endif
+
+/**
+ * @brief Report the invalid actions through exceptions (1), or through a status flag (0).
+ *
+ * @remark It defaults to 0 when the code is built without exceptions (-fno-exceptions), or when
+ * UNTANGLE_NO_EXCEPTIONS is defined, to keep the landing pads out of the dispatch loops.
+ */
+#ifndef UNTANGLE_EXCEPTIONS
+#if !defined(UNTANGLE_NO_EXCEPTIONS) && (defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
+#define UNTANGLE_EXCEPTIONS 1
+#else
+#define UNTANGLE_EXCEPTIONS 0
+#endif
+#endif
 
 namespace untangle
 {
@@ -40,15 +83,401 @@ struct invalid_action : private std::exception
   std::string what; //!< It holds the message text.
 };
 
+/**
+ * @brief Outcome of invoking one action.
+ *
+ */
+enum class action_status
+{
+  invoked, //!< The action was invoked.
+  not_found, //!< There is no action with the requested name.
+  invalid //!< The action is an invalid binding (see \ref bind()); it was removed.
+};
+
+/**
+ * @brief Priority of an action, for the emissions with a time budget.
+ *
+ * @remark See actuator::add(actionT*, action_priority, key_filter) and actuator::emit_within().
+ */
+enum class action_priority : std::uint8_t
+{
+  essential, //!< Always invoked.
+  optional //!< Skipped by actuator::emit_within() once the time budget is exhausted.
+};
+
+/**
+ * @brief Results container of the actuators whose actions have a void return type.
+ *
+ * It holds no storage, it only provides the read interface of a container that is always empty.
+ */
+struct no_results
+{
+  constexpr std::size_t size() const { return 0; }
+  constexpr bool empty() const { return true; }
+  constexpr const int* begin() const { return nullptr; }
+  constexpr const int* end() const { return nullptr; }
+  constexpr void clear() const {}
+};
+
+/**
+ * @brief Subscription filter of an action: the range of emission keys it is invoked for.
+ *
+ * @remark See actuator::add(actionT*, key_filter) and actuator::invokeMatching().
+ */
+struct key_filter
+{
+  std::int32_t low = std::numeric_limits<std::int32_t>::min(); //!< Lowest key accepted.
+  std::int32_t high = std::numeric_limits<std::int32_t>::max(); //!< Highest key accepted.
+
+  /**
+   * @brief A filter accepting one single key.
+   */
+  static constexpr key_filter key(std::int32_t k) { return {k, k}; }
+
+  /**
+   * @brief A filter accepting the keys in [low, high].
+   */
+  static constexpr key_filter range(std::int32_t low, std::int32_t high) { return {low, high}; }
+
+  /**
+   * @brief A filter accepting any key.
+   */
+  static constexpr key_filter any() { return {}; }
+
+  constexpr bool matches(std::int32_t k) const { return low <= k && k <= high; }
+};
+
+namespace detail
+{
+#if !UNTANGLE_EXCEPTIONS
+/**
+ * @brief Reason of the last invalid action invoked by the calling thread, null if none.
+ *
+ * @remark Without exceptions, an invalid binding sets it and returns a default result; the actuator checks it
+ * after each action.
+ */
+inline const char*& invalid_action_reason()
+{
+  thread_local const char* reason = nullptr;
+  return reason;
+}
+#endif
+
+/**
+ * @brief Report an invalid action to the actuator invoking it: by throwing \ref invalid_action, or by setting
+ * \ref invalid_action_reason() and returning a default constructed result.
+ *
+ */
+template<typename resultT>
+resultT invalid_action_result(const char* reason)
+{
+#if UNTANGLE_EXCEPTIONS
+  throw invalid_action(reason);
+#else
+  invalid_action_reason() = reason;
+  return resultT();
+#endif
+}
+
+/**
+ * @brief Invoke an action, and detect if it reported itself as invalid.
+ *
+ * @return true - if the action was invoked.
+ * @return false - if the action is an invalid binding; the reason is printed.
+ */
+template<typename callT>
+bool guard_action(callT&& call)
+{
+#if UNTANGLE_EXCEPTIONS
+  try
+  {
+    call();
+    return true;
+  }
+  catch (const invalid_action& ia)
+  {
+    std::cout << ia.what.c_str() << std::endl;
+    return false;
+  }
+#else
+  // a dead binding called outside of an actuator leaves its reason behind
+  auto& reason = invalid_action_reason();
+  reason = nullptr;
+  call();
+  if (reason)
+  {
+    std::cout << reason << std::endl;
+    reason = nullptr;
+    return false;
+  }
+  return true;
+#endif
+}
+
+/**
+ * @brief A new action table revision, unique in the process.
+ *
+ */
+inline std::uint64_t next_revision()
+{
+  static std::atomic<std::uint64_t> revision{0};
+  return revision.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+/**
+ * @brief Base of the objects shared through \ref shared_ref.
+ *
+ * @remark Copying an object does not copy its reference counter.
+ */
+struct ref_counted
+{
+  ref_counted() = default;
+  ref_counted(const ref_counted&) noexcept {}
+  ref_counted& operator=(const ref_counted&) noexcept { return *this; }
+
+  mutable std::atomic<std::size_t> references{1}; //!< Number of \ref shared_ref pointing to this object.
+};
+
+/**
+ * @brief Intrusive reference counting pointer, the size of a raw pointer.
+ *
+ * @tparam T Shared object type. It must derive from \ref ref_counted, and release its storage in a static
+ * `T::destroy(T*)`.
+ */
+template<typename T>
+struct shared_ref
+{
+  shared_ref() = default;
+  explicit shared_ref(T* object) : ptr(object) {}
+  shared_ref(const shared_ref& other) noexcept : ptr(other.ptr)
+  {
+    if (ptr)
+    {
+      ptr->references.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  shared_ref(shared_ref&& other) noexcept : ptr(other.ptr)
+  {
+    other.ptr = nullptr;
+  }
+  ~shared_ref()
+  {
+    reset();
+  }
+
+  shared_ref& operator=(shared_ref other) noexcept
+  {
+    std::swap(ptr, other.ptr);
+    return *this;
+  }
+
+  void reset()
+  {
+    if (ptr && ptr->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      T::destroy(ptr);
+    }
+    ptr = nullptr;
+  }
+
+  /**
+   * @brief Check if this is the only reference to the shared object.
+   */
+  bool unique() const { return ptr->references.load(std::memory_order_acquire) == 1; }
+
+  T* get() const { return ptr; }
+  T* operator->() const { return ptr; }
+  T& operator*() const { return *ptr; }
+  explicit operator bool() const { return ptr != nullptr; }
+
+  private:
+  T* ptr = nullptr;
+};
+
+/**
+ * @brief Call \p function with the index of every filter matching \p key, in increasing order.
+ *
+ * The filters are given as two packed arrays, of the lowest and highest keys accepted by each filter.
+ * They are compared with the key 8 (AVX2) or 4 (SSE2) at a time, so that a large number of filters
+ * costs a few vector compares per matching action.
+ */
+template<typename functionT>
+void match_keys(const std::int32_t* low, const std::int32_t* high, std::size_t size, std::int32_t key,
+                functionT&& function)
+{
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i key8 = _mm256_set1_epi32(key);
+  for (; i + 8 <= size; i += 8)
+  {
+    const __m256i low8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(low + i));
+    const __m256i high8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(high + i));
+    const __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(low8, key8), _mm256_cmpgt_epi32(key8, high8));
+    auto mask = ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(outside))) & 0xffu;
+    for (; mask; mask &= mask - 1)
+    {
+      function(i + static_cast<std::size_t>(__builtin_ctz(mask)));
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i key4 = _mm_set1_epi32(key);
+  for (; i + 4 <= size; i += 4)
+  {
+    const __m128i low4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low + i));
+    const __m128i high4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high + i));
+    const __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(low4, key4), _mm_cmpgt_epi32(key4, high4));
+    auto mask = ~static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(outside))) & 0xfu;
+    for (; mask; mask &= mask - 1)
+    {
+      function(i + static_cast<std::size_t>(__builtin_ctz(mask)));
+    }
+  }
+#endif
+  for (; i < size; ++i)
+  {
+    if (low[i] <= key && key <= high[i])
+    {
+      function(i);
+    }
+  }
+}
+
+template<typename T>
+struct is_tuple : std::false_type {};
+
+template<typename ...Ts>
+struct is_tuple<std::tuple<Ts...>> : std::true_type {};
+
+/**
+ * @brief Call a function with a payload: the elements of a std::tuple, or a single value.
+ *
+ */
+template<typename functionT, typename payloadT>
+decltype(auto) apply_payload(functionT&& function, const payloadT& payload)
+{
+  if constexpr (is_tuple<payloadT>::value)
+  {
+    return std::apply(std::forward<functionT>(function), payload);
+  }
+  else
+  {
+    return std::forward<functionT>(function)(payload);
+  }
+}
+
+template<typename allocatorT, typename T>
+using rebind_alloc = typename std::allocator_traits<allocatorT>::template rebind_alloc<T>;
+
+/**
+ * @brief Holder of the actuator allocator.
+ *
+ * @remark An empty allocator, like std::allocator, is not stored, so it adds nothing to the actuator size.
+ */
+template<typename allocatorT, bool isEmpty = std::is_empty_v<allocatorT>>
+struct allocator_holder
+{
+  allocator_holder() = default;
+  explicit allocator_holder(const allocatorT& allocator) : allocator(allocator) {}
+
+  allocatorT get_allocator() const { return allocator; }
+
+  private:
+  allocatorT allocator;
+};
+
+template<typename allocatorT>
+struct allocator_holder<allocatorT, true>
+{
+  allocator_holder() = default;
+  explicit allocator_holder(const allocatorT&) {}
+
+  allocatorT get_allocator() const { return allocatorT(); }
+};
+
+/**
+ * @brief Holder of the actuator results, for actions with a non-void return type.
+ *
+ */
+template<typename resultT, typename allocatorT, bool isVoid = std::is_void_v<resultT>>
+struct results_holder
+{
+  /**
+   * @brief Results container type.
+   *
+   * It holds the return values of the actions that have a non-void return type.
+   * Upon the actuator invocation, the returns can be extracted from \ref results.
+   */
+  using resultsT = std::vector<resultT, rebind_alloc<allocatorT, resultT>>;
+
+  results_holder() = default;
+  explicit results_holder(const allocatorT& allocator) : results(allocator) {}
+  // a copy keeps the allocator, as the copies of the action table do
+  results_holder(const results_holder& other) : results(other.results, other.results.get_allocator()) {}
+  results_holder(results_holder&& other) noexcept = default;
+
+  resultsT results; //!< Actions return values list.
+};
+
+/**
+ * @brief Holder of the actuator results, for actions with a void return type.
+ *
+ * @remark The results container is static and empty, so it adds nothing to the actuator size.
+ */
+template<typename resultT, typename allocatorT>
+struct results_holder<resultT, allocatorT, true>
+{
+  using resultsT = no_results;
+
+  results_holder() = default;
+  explicit results_holder(const allocatorT&) {}
+
+  static constexpr resultsT results{}; //!< Always empty.
+};
+
+/**
+ * @brief Order of the action names, comparing names of any string type.
+ *
+ */
+struct name_less
+{
+  using is_transparent = void;
+
+  template<typename nameT1, typename nameT2>
+  bool operator()(const nameT1& a, const nameT2& b) const
+  {
+    return std::string_view(a) < std::string_view(b);
+  }
+};
+
+/**
+ * @brief The first 8 bytes of a name, padded with zeros, as a number ordered as the names.
+ *
+ * @remark Two names with different numbers are ordered by them; the others must be compared in full.
+ */
+inline std::uint64_t name_prefix(std::string_view name)
+{
+  std::uint64_t prefix = 0;
+  for (std::size_t i = 0; i < sizeof(prefix); ++i)
+  {
+    prefix = prefix << 8 | (i < name.size() ? static_cast<unsigned char>(name[i]) : 0u);
+  }
+  return prefix;
+}
+} // namespace detail
+
 /**
  * @brief An actuator is a functor that can trigger a dynamic list of actions (of type std::function<...>).
  *
  *@remark An actuator object can be constructed with an initial list of actions by \ref connect().
  *
  * @tparam actionT Action type. It is specified as std::function<...>.
+ * @tparam allocatorT Allocator of the action table, the named actions and the results; it is rebound for each of
+ * them. See \ref untangle::pmr::actuator for memory resources.
  */
-template<typename actionT>
-struct actuator final
+template<typename actionT, typename allocatorT = std::allocator<actionT*>>
+struct actuator final : detail::allocator_holder<allocatorT>,
+                        detail::results_holder<typename actionT::result_type, allocatorT>
 {
   /**
    * @brief Actions container type.
@@ -56,194 +485,1490 @@ struct actuator final
    * @remark The elements stored are of pointer type, that is required to implement the remove() operation.
    * std::function supports only equality operator for nullptr (two std::function(s) can not compare).
    */
-  using actionsT = std::list<actionT*>;
-  using mapActionsT = std::map<std::string, actionT*>;
+  using actionsT = std::vector<actionT*, detail::rebind_alloc<allocatorT, actionT*>>;
+  /**
+   * @brief Name type of the named actions: std::string, or a string using the actuator allocator.
+   *
+   */
+  using nameT = std::conditional_t<std::is_same_v<allocatorT, std::allocator<actionT*>>, std::string,
+                                   std::basic_string<char, std::char_traits<char>, detail::rebind_alloc<allocatorT, char>>>;
+  using mapActionsT = std::map<nameT, actionT*,
+                               std::conditional_t<std::is_same_v<nameT, std::string>, std::less<nameT>, detail::name_less>,
+                               detail::rebind_alloc<allocatorT, std::pair<const nameT, actionT*>>>;
   using resultT = std::conditional<std::is_void<typename actionT::result_type>::value, int, typename actionT::result_type>;
+  using typename detail::results_holder<typename actionT::result_type, allocatorT>::resultsT;
+  using detail::results_holder<typename actionT::result_type, allocatorT>::results;
+  using detail::allocator_holder<allocatorT>::get_allocator;
+
+  /**
+   * @brief Outcome of an emission with a time budget, see \ref emit_within().
+   *
+   */
+  struct deadline_report
+  {
+    std::size_t invoked = 0; //!< Number of actions invoked.
+    std::vector<actionT*> skipped; //!< Optional actions skipped because the budget was exhausted, in order.
+  };
+
+  /**
+   * @brief Hit counts of the named actions, and a direct-mapped cache of the hottest ones, see \ref track_hits().
+   *
+   * @remark The counters are indexed by name hash: the names sharing a counter add up their hits. They are atomic,
+   * as the lookups of all the copies sharing a table count their hits in it. The cache refers to the elements of
+   * the named actions map of its table, and it is changed only with the map.
+   */
+  struct hit_tracker
+  {
+    using elementT = typename mapActionsT::value_type;
+    using countersT = std::vector<std::atomic<std::uint32_t>, detail::rebind_alloc<allocatorT, std::atomic<std::uint32_t>>>;
+
+    /**
+     * @brief Cached named action.
+     *
+     */
+    struct hot_entry
+    {
+      std::size_t hash = 0; //!< Hash of the name.
+      const elementT* element = nullptr; //!< Element of the named actions map, null if the slot is free.
+    };
+
+    using cacheT = std::vector<hot_entry, detail::rebind_alloc<allocatorT, hot_entry>>;
+
+    static constexpr std::size_t minCacheSize = 256; //!< Least number of cache slots, a power of 2.
+    static constexpr std::size_t maxCacheSize = 65536; //!< Most number of cache slots, a power of 2.
+    static constexpr std::size_t namesPerSlot = 1; //!< Number of names per cache slot the cache is sized for.
+    static constexpr std::size_t countersPerSlot = 4; //!< Number of hit counters per cache slot.
+
+    /**
+     * @brief A tracker sized for a number of names.
+     *
+     */
+    hit_tracker(const allocatorT& allocator, std::size_t names)
+    : counters(countersPerSlot * cacheSlots(names), allocator)
+    , cache(cacheSlots(names), allocator)
+    , cacheShift(shift(cache.size()))
+    {
+    }
+
+    /**
+     * @brief Copy the counters, and the cache rebuilt against the named actions map of the new table.
+     *
+     */
+    hit_tracker(const hit_tracker& other, const std::optional<mapActionsT>& named, const allocatorT& allocator)
+    : counters(other.counters.size(), allocator)
+    , cache(other.cache.size(), allocator)
+    , cacheShift(other.cacheShift)
+    {
+      for (std::size_t i = 0; i < counters.size(); ++i)
+      {
+        counters[i].store(other.counters[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      for (std::size_t i = 0; i < cache.size(); ++i)
+      {
+        if (other.cache[i].element && named)
+        {
+          const auto it = named->find(other.cache[i].element->first);
+          if (it != named->end())
+          {
+            cache[i] = {other.cache[i].hash, &*it};
+          }
+        }
+      }
+    }
+
+    static std::size_t hash(std::string_view name) { return std::hash<std::string_view>()(name); }
+
+    /**
+     * @brief Number of cache slots for a number of names: a power of 2, so that the hottest names of a large map
+     * still get a slot of their own.
+     *
+     */
+    static std::size_t cacheSlots(std::size_t names)
+    {
+      std::size_t slots = minCacheSize;
+      while (slots < maxCacheSize && slots * namesPerSlot < names)
+      {
+        slots *= 2;
+      }
+      return slots;
+    }
+
+    /**
+     * @brief Number of bits of a power of 2 number of slots.
+     *
+     */
+    static std::size_t shift(std::size_t slots)
+    {
+      std::size_t bits = 0;
+      while ((std::size_t(1) << bits) < slots)
+      {
+        ++bits;
+      }
+      return bits;
+    }
+
+    void count(std::size_t hash) const { counters[counter(hash)].fetch_add(1, std::memory_order_relaxed); }
+
+    std::uint32_t hits(std::size_t hash) const { return counters[counter(hash)].load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Counter of a hash: the bits above the cache slot ones, so the names sharing a counter seldom compete
+     * for the same slot.
+     *
+     */
+    std::size_t counter(std::size_t hash) const { return (hash >> cacheShift) & (counters.size() - 1); }
+
+    /**
+     * @brief The cached element of a name, or null.
+     *
+     */
+    const elementT* find(std::size_t hash, std::string_view name) const
+    {
+      const auto& entry = cache[hash & (cache.size() - 1)];
+      return entry.element && entry.hash == hash && std::string_view(entry.element->first) == name ? entry.element : nullptr;
+    }
+
+    /**
+     * @brief Drop an element from the cache, before it is erased from the map.
+     *
+     */
+    void forget(const elementT* element)
+    {
+      // an element can only be cached in the slot of its hash
+      auto& entry = cache[hash(element->first) & (cache.size() - 1)];
+      if (entry.element == element)
+      {
+        entry = hot_entry();
+      }
+    }
+
+    /**
+     * @brief Cache the hottest named actions, one per slot, then halve the counters so that they follow the
+     * changes of the workload.
+     *
+     * The cache is resized first if the number of names has changed its size: it is then filled from the current
+     * counts, and the counters start again from zero with the new size.
+     */
+    void reorganize(const mapActionsT& named)
+    {
+      const auto slots = cacheSlots(named.size());
+      if (slots != cache.size())
+      {
+        cache.assign(slots, hot_entry());
+      }
+      else
+      {
+        std::fill(cache.begin(), cache.end(), hot_entry());
+      }
+      std::vector<std::uint32_t> cachedHits(slots, 0);
+      for (const auto& element : named)
+      {
+        const auto h = hash(element.first);
+        const auto slot = h & (slots - 1);
+        const auto elementHits = hits(h);
+        if (elementHits > cachedHits[slot])
+        {
+          cache[slot] = {h, &element};
+          cachedHits[slot] = elementHits;
+        }
+      }
+      if (counters.size() != countersPerSlot * slots)
+      {
+        countersT(countersPerSlot * slots, counters.get_allocator()).swap(counters);
+        cacheShift = shift(slots);
+        return;
+      }
+      for (auto& counter : counters)
+      {
+        counter.store(counter.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+      }
+    }
+
+    mutable countersT counters; //!< Hits per name hash.
+    cacheT cache; //!< Hottest named actions, by name hash.
+    std::size_t cacheShift; //!< Number of hash bits selecting the cache slot.
+  };
+
+  /**
+   * @brief Action table, holding both the actions list and the named actions map.
+   *
+   * @remark A table is shared by all the copies of an actuator and it is never modified while shared.
+   * The first mutation through one of the copies clones it (copy-on-write), so copying an actuator is O(1).
+   * The named actions map is allocated only when a named action is added, and the filter keys only when a
+   * filtered action is added. The table and all its containers are allocated by the actuator allocator.
+   */
+  struct action_table : detail::ref_counted
+  {
+    using keysT = std::vector<std::int32_t, detail::rebind_alloc<allocatorT, std::int32_t>>;
+    using prioritiesT = std::vector<action_priority, detail::rebind_alloc<allocatorT, action_priority>>;
+
+    explicit action_table(const allocatorT& allocator = allocatorT())
+    : actions(allocator)
+    , keyLow(allocator)
+    , keyHigh(allocator)
+    , priorities(allocator)
+    {
+    }
+
+    action_table(const action_table& other, const allocatorT& allocator)
+    : ref_counted(other)
+    , actions(other.actions, allocator)
+    , keyLow(other.keyLow, allocator)
+    , keyHigh(other.keyHigh, allocator)
+    , priorities(other.priorities, allocator)
+    , revision(other.revision)
+    {
+      if (other.mapActions)
+      {
+        mapActions.emplace(*other.mapActions, allocator);
+      }
+      if (other.hits)
+      {
+        hits.emplace(*other.hits, mapActions, allocator);
+      }
+    }
+
+    /**
+     * @brief Allocate a table with an allocator.
+     *
+     */
+    template<typename ...Args>
+    static action_table* create(const allocatorT& allocator, const Args&... args)
+    {
+      detail::rebind_alloc<allocatorT, action_table> tableAllocator(allocator);
+      auto* table = std::allocator_traits<decltype(tableAllocator)>::allocate(tableAllocator, 1);
+      return new (table) action_table(args..., allocator);
+    }
+
+    /**
+     * @brief Release a table allocated by \ref create().
+     *
+     */
+    static void destroy(action_table* table)
+    {
+      detail::rebind_alloc<allocatorT, action_table> tableAllocator(table->actions.get_allocator());
+      table->~action_table();
+      std::allocator_traits<decltype(tableAllocator)>::deallocate(tableAllocator, table, 1);
+    }
+
+    /**
+     * @brief Append an action with its filter and priority.
+     *
+     */
+    void push_back(actionT* action, key_filter filter, action_priority priority = action_priority::essential)
+    {
+      if (priority != action_priority::essential && priorities.empty())
+      {
+        // the first optional action: the previous actions are essential
+        priorities.assign(actions.size(), action_priority::essential);
+      }
+      if (priority != action_priority::essential || !priorities.empty())
+      {
+        priorities.push_back(priority);
+      }
+      const bool filtered = filter.low != key_filter::any().low || filter.high != key_filter::any().high;
+      if (filtered && keyLow.empty())
+      {
+        // the first filtered action: the previous actions accept any key
+        keyLow.assign(actions.size(), key_filter::any().low);
+        keyHigh.assign(actions.size(), key_filter::any().high);
+      }
+      actions.push_back(action);
+      if (filtered || !keyLow.empty())
+      {
+        keyLow.push_back(filter.low);
+        keyHigh.push_back(filter.high);
+      }
+    }
+
+    /**
+     * @brief Remove the actions satisfying a predicate, together with their filters.
+     *
+     */
+    template<typename predicateT>
+    void erase_if(predicateT&& predicate)
+    {
+      std::size_t kept = 0;
+      for (std::size_t i = 0; i < actions.size(); ++i)
+      {
+        if (!predicate(actions[i]))
+        {
+          actions[kept] = actions[i];
+          if (!keyLow.empty())
+          {
+            keyLow[kept] = keyLow[i];
+            keyHigh[kept] = keyHigh[i];
+          }
+          if (!priorities.empty())
+          {
+            priorities[kept] = priorities[i];
+          }
+          ++kept;
+        }
+      }
+      actions.resize(kept);
+      if (!keyLow.empty())
+      {
+        keyLow.resize(kept);
+        keyHigh.resize(kept);
+      }
+      if (!priorities.empty())
+      {
+        priorities.resize(kept);
+      }
+    }
+
+    actionsT actions; //!< Actions list.
+    keysT keyLow; //!< Lowest key accepted by each action, empty if no action is filtered.
+    keysT keyHigh; //!< Highest key accepted by each action, empty if no action is filtered.
+    prioritiesT priorities; //!< Priority of each action, empty if all the actions are essential.
+    std::optional<mapActionsT> mapActions; //!< Named actions map, empty until used.
+    std::optional<hit_tracker> hits; //!< Hit counts of the named actions, empty unless tracked.
+    std::uint64_t revision = 0; //!< Changed by each modification, see actuator::revision().
+  };
+
+  actuator() = default;
+  actuator(const actuator& other) = default;
+  actuator(actuator&& other) noexcept = default;
+  ~actuator() = default;
+
+  /**
+   * @brief Construct an actuator using an allocator, for instance a std::pmr::polymorphic_allocator.
+   *
+   */
+  explicit actuator(const allocatorT& allocator)
+  : detail::allocator_holder<allocatorT>(allocator)
+  , detail::results_holder<typename actionT::result_type, allocatorT>(allocator)
+  {
+  }
+
+  /**
+   * @brief Construct an actuator holding an initial list of actions.
+   *
+   * @param actions - Initial actions list. Its allocator becomes the actuator allocator.
+   */
+  explicit actuator(actionsT actions)
+  : actuator(allocatorT(actions.get_allocator()))
+  {
+    if (!actions.empty())
+    {
+      mutableTable().actions = std::move(actions);
+    }
+  }
+
+  /**
+   * @brief Construct an actuator holding an initial map of named actions.
+   *
+   * @param mapActions - Initial named actions map. Its allocator becomes the actuator allocator.
+   */
+  explicit actuator(mapActionsT mapActions)
+  : actuator(allocatorT(mapActions.get_allocator()))
+  {
+    if (!mapActions.empty())
+    {
+      mutableTable().mapActions.emplace(std::move(mapActions));
+    }
+  }
+
+  /**
+   * @brief Helper method to access the action type of this object.
+   *
+   * @note Intended to be used in expressions by `decltype(<actuator instance>.type()`
+   *
+   * @return actionT
+   */
+  actionT type()
+  {
+    return nullptr;
+  }
+
+  /**
+   * @brief Assignment operator.
+   *
+   * The action table is shared with \p other, it is not copied, unless their allocators differ: it is then
+   * cloned with the allocator of this actuator, which keeps it.
+   *
+   * Example:
+   * \snippet test_actuator.cpp test_assignment
+   */
+  actuator& operator=(const actuator& other)
+  {
+    if (sameAllocator(other))
+    {
+      actionTable = other.actionTable;
+    }
+    else
+    {
+      cloneTable(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * Like the assignment operator, it takes over only the action table of \p other, or clones it if their
+   * allocators differ.
+   */
+  actuator& operator=(actuator&& other) noexcept(std::allocator_traits<allocatorT>::is_always_equal::value)
+  {
+    if (sameAllocator(other))
+    {
+      actionTable = std::move(other.actionTable);
+    }
+    else
+    {
+      cloneTable(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Remove all the actions, positional and named.
+   */
+  void reset()
+  {
+    actionTable.reset();
+  }
+
+  /**
+   * @brief Read access to the actions list.
+   *
+   * @return The actions list, possibly shared with other copies of this actuator.
+   */
+  const actionsT& actions() const
+  {
+    return table().actions;
+  }
+
+  /**
+   * @brief Read access to the named actions map.
+   *
+   * @return The named actions map, possibly shared with other copies of this actuator.
+   */
+  const mapActionsT& mapActions() const
+  {
+    static const mapActionsT empty;
+    const auto& named = table().mapActions;
+    return named ? *named : empty;
+  }
+
+  /**
+   * @brief The call operator.
+   *
+   * Actions in the actuator#actions list are triggered by invoking the call operator.
+   *
+   * @remark The actions are invoked from a snapshot of the action table, so an action may safely add or remove
+   * actions of this actuator. The changes take effect from the next invocation.
+   *
+   * @param args - Arguments list must match the action arity.
+   */
+  template<typename ...Args>
+  void operator()(Args&&... args)
+  {
+    UNTANGLE_TRACE_SCOPE(this, nullptr, "operator()", 10);
+    results.clear();
+    // keep the table alive, and shared, while the actions run
+    auto snapshot = actionTable;
+    if (snapshot && dispatch(*snapshot, std::forward<Args>(args)...))
+    {
+      // released first, so that a table no other actuator shares is not cloned
+      snapshot.reset();
+      eraseEmptyActions();
+    }
+  }
+
+  /**
+   * @brief Invokes the actions with arguments built only if there is an action to invoke.
+   *
+   * The factory is called at most once, and its result is passed, read-only, to every action.
+   *
+   * @param factory - Callable returning the argument, or a std::tuple of the arguments.
+   * @return true - if the factory was called and the actions invoked.
+   * @return false - if there is no valid action: the factory was not called.
+   */
+  template<typename factoryT>
+  bool emit_lazy(factoryT&& factory)
+  {
+    UNTANGLE_TRACE_SCOPE(this, nullptr, "emit_lazy()", 11);
+    results.clear();
+    auto snapshot = actionTable;
+    if (!snapshot || std::none_of(snapshot->actions.begin(), snapshot->actions.end(), [](const actionT* action)
+    {
+      return action && *action;
+    }))
+    {
+      return false;
+    }
+    const auto payload = std::forward<factoryT>(factory)();
+    if (detail::apply_payload([this, &snapshot](const auto&... args) { return dispatch(*snapshot, args...); }, payload))
+    {
+      snapshot.reset();
+      eraseEmptyActions();
+    }
+    return true;
+  }
+
+  /**
+   * @brief Invokes a named action with arguments built only if the action exists.
+   *
+   * @param name - Key associated with the action.
+   * @param factory - Callable returning the argument, or a std::tuple of the arguments.
+   * @return The outcome of the invocation; the factory is called only if the action is found.
+   */
+  template<typename factoryT>
+  action_status emit_lazy(const std::string& name, factoryT&& factory)
+  {
+    UNTANGLE_TRACE_SCOPE(this, nullptr, name.data(), name.size());
+    results.clear();
+    auto snapshot = actionTable;
+    auto* action = findNamed(snapshot.get(), name);
+    if (!action)
+    {
+      return action_status::not_found;
+    }
+    const auto payload = std::forward<factoryT>(factory)();
+    const auto status = detail::apply_payload([this, action, &name](const auto&... args)
+    {
+      return invokeNamed(action, name, args...);
+    }, payload);
+    if (status == action_status::invalid)
+    {
+      snapshot.reset();
+      eraseInvalidName(name);
+    }
+    return status;
+  }
+
+  /**
+   * @brief Invokes the actions, passing the result of each one to a sink instead of storing it in \ref results.
+   *
+   * It is the building block of the pipelines (see actuator_pipeline.hpp): the results of one actuator stream into
+   * the actions of the next one, without being collected in between.
+   *
+   * @param sink - Callable invoked after each action, with its result; without arguments for void actions.
+   * @param args - Arguments list must match the action arity.
+   */
+  template<typename sinkT, typename ...Args>
+  void invokeEach(sinkT&& sink, Args&&... args)
+  {
+    UNTANGLE_TRACE_SCOPE(this, nullptr, "invokeEach()", 12);
+    auto snapshot = actionTable;
+    if (!snapshot)
+    {
+      return;
+    }
+    bool hasEmptyActions = false;
+    for (const auto& action : snapshot->actions)
+    {
+      if (action && *action)
+      {
+        UNTANGLE_TRACE_SCOPE(this, action, "invokeEach()", 12);
+        std::optional<typename resultT::type> result;
+        const bool invoked = detail::guard_action([&]()
+        {
+          if constexpr (std::is_void_v<typename actionT::result_type>)
+          {
+            (*action)(args...);
+          }
+          else
+          {
+            result.emplace((*action)(args...));
+          }
+        });
+        // the sink runs outside of the guard: an invalid action downstream must not reset this one
+        if (invoked)
+        {
+          if constexpr (std::is_void_v<typename actionT::result_type>)
+          {
+            sink();
+          }
+          else
+          {
+            sink(std::move(*result));
+          }
+        }
+        else
+        {
+          *action = nullptr;
+          hasEmptyActions = true;
+        }
+      }
+      else
+      {
+        hasEmptyActions = true;
+      }
+    }
+    if (hasEmptyActions)
+    {
+      snapshot.reset();
+      eraseEmptyActions();
+    }
+  }
+
+  /**
+   * @brief Invokes the actions whose filter matches a key.
+   *
+   * Actions added without a filter match any key. The filters are evaluated with vector compares over packed
+   * key arrays, so the actions that do not match cost no call.
+   *
+   * @param key - Emission key, for instance an object or symbol id.
+   * @param args - Arguments list must match the action arity.
+   */
+  template<typename ...Args>
+  void invokeMatching(std::int32_t key, Args&&... args)
+  {
+    UNTANGLE_TRACE_SCOPE(this, nullptr, "invokeMatching()", 16);
+    results.clear();
+    auto snapshot = actionTable;
+    if (!snapshot)
+    {
+      return;
+    }
+    const auto& table = *snapshot;
+    bool hasEmptyActions = false;
+    const auto invoke = [&](std::size_t i)
+    {
+      const auto& action = table.actions[i];
+      if (action && *action)
+      {
+        UNTANGLE_TRACE_SCOPE(this, action, "invokeMatching()", 16);
+        hasEmptyActions |= !actuate(action, args...);
+      }
+      else
+      {
+        hasEmptyActions = true;
+      }
+    };
+    if (table.keyLow.empty())
+    {
+      for (std::size_t i = 0; i < table.actions.size(); ++i)
+      {
+        invoke(i);
+      }
+    }
+    else
+    {
+      detail::match_keys(table.keyLow.data(), table.keyHigh.data(), table.actions.size(), key, invoke);
+    }
+    if (hasEmptyActions)
+    {
+      snapshot.reset();
+      eraseEmptyActions();
+    }
+  }
+
+  /**
+   * @brief Invokes the actions within a time budget.
+   *
+   * The essential actions are always invoked. Once the budget is exhausted, the remaining optional actions are
+   * skipped and reported, so the caller may defer them. The clock is read only before the optional actions.
+   *
+   * @param budget - Time budget of the emission.
+   * @param args - Arguments list must match the action arity.
+   * @return The number of invoked actions and the skipped ones.
+   */
+  template<typename ...Args>
+  deadline_report emit_within(std::chrono::nanoseconds budget, Args&&... args)
+  {
+    UNTANGLE_TRACE_SCOPE(this, nullptr, "emit_within()", 13);
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+    results.clear();
+    deadline_report report;
+    auto snapshot = actionTable;
+    if (!snapshot)
+    {
+      return report;
+    }
+    const auto& table = *snapshot;
+    bool expired = false;
+    bool hasEmptyActions = false;
+    for (std::size_t i = 0; i < table.actions.size(); ++i)
+    {
+      auto* action = table.actions[i];
+      if (!action || !*action)
+      {
+        hasEmptyActions = true;
+        continue;
+      }
+      if (!table.priorities.empty() && table.priorities[i] == action_priority::optional)
+      {
+        expired = expired || std::chrono::steady_clock::now() >= deadline;
+        if (expired)
+        {
+          report.skipped.push_back(action);
+          continue;
+        }
+      }
+      UNTANGLE_TRACE_SCOPE(this, action, "emit_within()", 13);
+      if (actuate(action, args...))
+      {
+        ++report.invoked;
+      }
+      else
+      {
+        hasEmptyActions = true;
+      }
+    }
+    if (hasEmptyActions)
+    {
+      snapshot.reset();
+      eraseEmptyActions();
+    }
+    return report;
+  }
+
+  /**
+   * @brief Invokes one single action associated with a key.
+   *
+   * @param name - Key associated with the action.
+   * @param args - Arguments list must match the action arity.
+   * @return The outcome of the invocation.
+   */
+  template<typename ...Args>
+  action_status invokeAction(std::string name, Args&&... args)
+  {
+    UNTANGLE_TRACE_SCOPE(this, nullptr, name.data(), name.size());
+    results.clear();
+    auto snapshot = actionTable;
+    auto* action = findNamed(snapshot.get(), name);
+    if (!action)
+    {
+      return action_status::not_found;
+    }
+    const auto status = invokeNamed(action, name, std::forward<Args>(args)...);
+    if (status == action_status::invalid)
+    {
+      snapshot.reset();
+      eraseInvalidName(name);
+    }
+    return status;
+  }
+
+  /**
+   * @brief Invokes several named actions with the same arguments.
+   *
+   * The names are resolved in one pass: sorted, then merged with the named actions map, or looked up one by one
+   * if they are few compared to the map. The actions are then invoked in the order of the names.
+   *
+   * @param names - Range of names: std::string, or any type a std::string can be constructed from, such as
+   * `const char*` or std::string_view; a braced list of names is taken as a list of std::string_view.
+   * @param args - Arguments list must match the action arity.
+   * @return The outcome of each invocation, in the order of the names. The results of the invoked actions are
+   * stored in \ref results, in the same order.
+   */
+  template<typename namesT = std::initializer_list<std::string_view>, typename ...Args>
+  std::vector<action_status> invokeActions(const namesT& names, Args&&... args)
+  {
+    UNTANGLE_TRACE_SCOPE(this, nullptr, "invokeActions()", 15);
+    results.clear();
+    auto snapshot = actionTable;
+    using referenceT = decltype(*std::begin(names));
+    std::vector<std::string> converted;
+    std::vector<const std::string*> requested;
+    if constexpr (std::is_lvalue_reference_v<referenceT> &&
+                  std::is_same_v<std::remove_cv_t<std::remove_reference_t<referenceT>>, std::string>)
+    {
+      for (const std::string& name : names)
+      {
+        requested.push_back(&name);
+      }
+    }
+    else
+    {
+      // other names are converted first, to be referred to until the actions are invoked
+      for (const auto& name : names)
+      {
+        converted.emplace_back(name);
+      }
+      for (const auto& name : converted)
+      {
+        requested.push_back(&name);
+      }
+    }
+    const auto resolved = resolveNames(snapshot.get(), requested);
+    std::vector<action_status> statuses(requested.size(), action_status::not_found);
+    for (std::size_t i = 0; i < requested.size(); ++i)
+    {
+      // an action may be found invalid by a previous invocation of the same name
+      if (resolved[i] && *resolved[i])
+      {
+        statuses[i] = invokeNamed(resolved[i], *requested[i], args...);
+      }
+    }
+    if (std::find(statuses.begin(), statuses.end(), action_status::invalid) != statuses.end())
+    {
+      snapshot.reset();
+      for (std::size_t i = 0; i < requested.size(); ++i)
+      {
+        if (statuses[i] == action_status::invalid)
+        {
+          eraseInvalidName(*requested[i]);
+        }
+      }
+    }
+    return statuses;
+  }
+
+  /**
+   * @brief Add an action to the actions list.
+   *
+   * @param action - Action to be added.
+   *
+   * Example:
+   * \snippet test_actuator.cpp test_add
+   */
+  void add(actionT* action)
+  {
+    mutableTable().push_back(action, key_filter::any());
+  }
+
+  /**
+   * @brief Add an action to the actions list, invoked only for the keys accepted by a filter.
+   *
+   * The filter applies to \ref invokeMatching(); the call operator invokes the action regardless of it.
+   *
+   * @param action - Action to be added.
+   * @param filter - Range of emission keys the action subscribes to.
+   */
+  void add(actionT* action, key_filter filter)
+  {
+    mutableTable().push_back(action, filter);
+  }
+
+  /**
+   * @brief Add an action to the actions list, with a priority.
+   *
+   * The priority applies to \ref emit_within(); the other emissions invoke the action regardless of it.
+   *
+   * @param action - Action to be added.
+   * @param priority - Whether the action may be skipped when the time budget of an emission is exhausted.
+   * @param filter - Range of emission keys the action subscribes to.
+   */
+  void add(actionT* action, action_priority priority, key_filter filter = key_filter::any())
+  {
+    mutableTable().push_back(action, filter, priority);
+  }
+
+  /**
+   * @brief Add action to the actions map associated with a name.
+   *
+   * @param name - Name of the action.
+   * @param action - Action to be added.
+   */
+  void add(std::string name, actionT* action)
+  {
+    mutableMapActions().emplace(std::move(name), action);
+  }
+
+  /**
+   * @brief Reserve storage for a number of positional actions, before adding them one by one.
+   *
+   * The actions do not change, nor the \ref revision(). The named actions map has no storage to reserve.
+   *
+   * @param actions - Number of positional actions.
+   */
+  void reserve(std::size_t actions)
+  {
+    auto& table = ownTable();
+    table.actions.reserve(actions);
+    if (!table.keyLow.empty())
+    {
+      table.keyLow.reserve(actions);
+      table.keyHigh.reserve(actions);
+    }
+    if (!table.priorities.empty())
+    {
+      table.priorities.reserve(actions);
+    }
+  }
+
+  /**
+   * @brief Add a range of actions in one operation.
+   *
+   * The range holds either actions (`actionT*`), appended to the actions list with a single allocation, or pairs
+   * of name and action, merged into the named actions map in one sorted pass: each element is inserted next to the
+   * previous one, in constant time instead of a full lookup. A sorted range is inserted as is; otherwise views of
+   * its names are sorted first, in one allocation from the actuator allocator, without copying the names.
+   * As with \ref add(std::string, actionT*), a name already present keeps its action.
+   *
+   * @param first - Beginning of the range.
+   * @param last - End of the range.
+   */
+  template<typename iteratorT>
+  void add_range(iteratorT first, iteratorT last)
+  {
+    using valueT = typename std::iterator_traits<iteratorT>::value_type;
+    if (first == last)
+    {
+      return;
+    }
+    if constexpr (std::is_convertible_v<valueT, actionT*>)
+    {
+      auto& table = mutableTable();
+      if (table.keyLow.empty() && table.priorities.empty())
+      {
+        table.actions.insert(table.actions.end(), first, last);
+      }
+      else
+      {
+        for (; first != last; ++first)
+        {
+          table.push_back(*first, key_filter::any());
+        }
+      }
+    }
+    else
+    {
+      static_assert(std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<iteratorT>::iterator_category>,
+                    "the named actions are added from a forward range");
+      const auto less = [](const valueT& a, const valueT& b)
+      {
+        return std::string_view(a.first) < std::string_view(b.first);
+      };
+      auto& named = mutableMapActions();
+      if (std::is_sorted(first, last, less))
+      {
+        insertSorted(named, first, last, [](const valueT& element)
+        {
+          return std::pair<std::string_view, actionT*>(element.first, element.second);
+        });
+        return;
+      }
+      // views of the names are sorted instead, by name then position, so that the first one of the same names is
+      // inserted; they are compared first by the 8 bytes following the prefix common to all the names
+      std::string_view common(first->first);
+      for (auto it = first; it != last && !common.empty(); ++it)
+      {
+        const std::string_view name(it->first);
+        common = common.substr(0, std::mismatch(common.begin(), common.end(), name.begin(), name.end()).first - common.begin());
+      }
+      using entryT = std::tuple<std::uint64_t, std::string_view, std::size_t, actionT*>;
+      std::vector<entryT, detail::rebind_alloc<allocatorT, entryT>> order(get_allocator());
+      order.reserve(static_cast<std::size_t>(std::distance(first, last)));
+      for (; first != last; ++first)
+      {
+        const std::string_view name(first->first);
+        order.emplace_back(detail::name_prefix(name.substr(common.size())), name, order.size(), first->second);
+      }
+      std::sort(order.begin(), order.end(), [](const entryT& a, const entryT& b)
+      {
+        if (std::get<0>(a) != std::get<0>(b))
+        {
+          return std::get<0>(a) < std::get<0>(b);
+        }
+        const auto compared = std::get<1>(a).compare(std::get<1>(b));
+        return compared < 0 || (compared == 0 && std::get<2>(a) < std::get<2>(b));
+      });
+      insertSorted(named, order.begin(), order.end(), [](const entryT& entry)
+      {
+        return std::pair<std::string_view, actionT*>(std::get<1>(entry), std::get<3>(entry));
+      });
+    }
+  }
+
+  /**
+   * @brief Remove the actions satisfying a predicate, in one pass.
+   *
+   * @param predicate - Callable taking an `actionT*`, returning true for the actions to remove.
+   * @return The number of actions removed.
+   */
+  template<typename predicateT>
+  std::size_t remove_if(predicateT&& predicate)
+  {
+    const auto size = actions().size();
+    if (std::none_of(actions().begin(), actions().end(), predicate))
+    {
+      return 0;
+    }
+    mutableTable().erase_if(predicate);
+    return size - actions().size();
+  }
+
+  /**
+   * @brief Remove the named actions satisfying a predicate, in one pass.
+   *
+   * @param predicate - Callable taking a name and an `actionT*`, returning true for the actions to remove.
+   * @return The number of actions removed.
+   */
+  template<typename predicateT>
+  std::size_t remove_named_if(predicateT&& predicate)
+  {
+    if (std::none_of(mapActions().begin(), mapActions().end(), [&predicate](const auto& element)
+    {
+      return predicate(element.first, element.second);
+    }))
+    {
+      return 0;
+    }
+    auto& named = mutableMapActions();
+    const auto size = named.size();
+    for (auto it = named.begin(); it != named.end();)
+    {
+      if (predicate(it->first, it->second))
+      {
+        forgetHot(&*it);
+        it = named.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+    return size - named.size();
+  }
+
+  /**
+   * @brief Remove an action from the actions list.
+   *
+   * An invalid action (empty std::function) is implicitly removed when operator()() is invoked.
+   *
+   * @param action - Action to be removed.
+   *
+   * Example:
+   * \snippet test_actuator.cpp test_add
+   */
+  void remove(const actionT* action)
+  {
+    if (std::find(actions().begin(), actions().end(), action) == actions().end())
+    {
+      return;
+    }
+    mutableTable().erase_if([&action](const auto& a)
+    {
+      return (action == a);
+    });
+  }
+
+  /**
+   * @brief Remove an action from actions map.
+   *
+   * @param name -  Name of the action to remove.
+   */
+  void remove(const std::string& name)
+  {
+    if (!has_action(name))
+    {
+      return;
+    }
+    eraseName(name);
+  }
+
+  /**
+   * @brief Check if this actuator is "connected" with other actions.
+   *
+   * @return true - if the actuator::actions list is not empty.
+   * @return false - if the actuator::actions list is empty.
+   */
+  bool is_connected() const { return !actions().empty() || !mapActions().empty(); }
+
+  /**
+   * @brief Check if there is certain named action.
+   *
+   * @param name - Name associated with the action.
+   * @return true - if name can be found in actuator::mapActions
+   * @return false - if name can not be found in actuator::mapActions
+   */
+  bool has_action(const std::string& name) const { return mapActions().find(name) != mapActions().end(); }
+
+  /**
+   * @brief Start, or stop, counting the hits of the named actions.
+   *
+   * The hits are counted by \ref invokeAction() and \ref invokeActions(), for all the copies sharing the actions.
+   * Tracking the hits does not change the actions, nor the \ref revision().
+   *
+   * @param enable - true to count the hits, false to drop the counts and the hot cache.
+   */
+  void track_hits(bool enable = true)
+  {
+    if (enable == (actionTable && actionTable->hits))
+    {
+      return;
+    }
+    auto& table = ownTable();
+    if (enable)
+    {
+      table.hits.emplace(get_allocator(), table.mapActions ? table.mapActions->size() : 0);
+    }
+    else
+    {
+      table.hits.reset();
+    }
+  }
+
+  /**
+   * @brief Number of hits counted for a named action, since the last \ref reorganize() halved them.
+   *
+   * @remark The count is shared with the names that have the same counter, so it may be higher than the hits of
+   * the action itself.
+   * @return 0 - if the hits are not tracked.
+   */
+  std::uint32_t hits(const std::string& name) const
+  {
+    const auto& tracker = table().hits;
+    return tracker ? tracker->hits(hit_tracker::hash(name)) : 0;
+  }
+
+  /**
+   * @brief Move the hottest named actions in a direct-mapped cache, looked up before the named actions map.
+   *
+   * To be called periodically, for instance every few thousands invocations: the hot names of a skewed workload
+   * are then found in the cache, a contiguous array sized from the number of names, instead of walking the map
+   * nodes. The counts are halved
+   * after each call, so the cache follows the changes of the workload.
+   * It does nothing if the hits are not tracked, see \ref track_hits().
+   */
+  void reorganize()
+  {
+    if (!actionTable || !actionTable->hits || !actionTable->mapActions)
+    {
+      return;
+    }
+    auto& table = ownTable();
+    table.hits->reorganize(*table.mapActions);
+  }
+
+  /**
+   * @brief Check if a named action is in the hot cache, see \ref reorganize().
+   *
+   */
+  bool is_hot(const std::string& name) const
+  {
+    const auto& tracker = table().hits;
+    return tracker && tracker->find(hit_tracker::hash(name), name) != nullptr;
+  }
+
+  /**
+   * @brief Revision of the actions: it changes each time actions are added or removed. Dropping the invalid
+   * actions found by an emission does not change it. Copies sharing the same actions have the same revision.
+   *
+   * @return 0 for a new actuator, or after \ref reset(); otherwise a value unique in the process.
+   */
+  std::uint64_t revision() const { return actionTable ? actionTable->revision : 0; }
+
+  private:
+  detail::shared_ref<action_table> actionTable; //!< Action table, shared between copies. Null if there are no actions.
+
+  /**
+   * @brief The action table, or an empty one if this actuator has no actions.
+   *
+   */
+  const action_table& table() const
+  {
+    static const action_table empty;
+    return actionTable ? *actionTable : empty;
+  }
+
+  /**
+   * @brief Check if the tables of another actuator may be shared: they are allocated the same way.
+   *
+   */
+  bool sameAllocator(const actuator& other) const
+  {
+    if constexpr (std::allocator_traits<allocatorT>::is_always_equal::value)
+    {
+      return true;
+    }
+    else
+    {
+      return get_allocator() == other.get_allocator();
+    }
+  }
+
+  /**
+   * @brief Replace the action table with a copy of the table of another actuator, using this actuator allocator.
+   *
+   */
+  void cloneTable(const actuator& other)
+  {
+    if (other.actionTable)
+    {
+      actionTable = detail::shared_ref<action_table>(action_table::create(get_allocator(), *other.actionTable));
+    }
+    else
+    {
+      actionTable.reset();
+    }
+  }
+
+  /**
+   * @brief The action table, ready to be modified.
+   *
+   * It is created on first use, and cloned if it is shared with other actuators.
+   */
+  action_table& mutableTable()
+  {
+    auto& table = ownTable();
+    table.revision = detail::next_revision();
+    return table;
+  }
+
   /**
-   * @brief Results container type.
+   * @brief The action table, not shared with other actuators, without changing its revision.
    *
-   * It holds the return values of the actions that have a non-void return type.
-   * Upon the actuator invocation, the returns can be extracted from \ref results.
+   * It is created on first use, and cloned if it is shared with other actuators.
    */
-  using resultsT = std::vector<typename resultT::type>;
-
-  actionsT actions; //!< Actions list.
-  mapActionsT mapActions; //!< Actions list.
-  resultsT results; //!< Actions return values list.
-
-  actuator() = default;
-  ~actuator()
+  action_table& ownTable()
   {
-    actions.clear();
+    if (!actionTable)
+    {
+      actionTable = detail::shared_ref<action_table>(action_table::create(get_allocator()));
+    }
+    else if (!actionTable.unique())
+    {
+      actionTable = detail::shared_ref<action_table>(action_table::create(get_allocator(), *actionTable));
+    }
+    return *actionTable;
   }
 
   /**
-   * @brief Helper method to access the action type of this object.
+   * @brief Insert a range of name and action pairs, sorted by name, each one next to the previous one.
    *
-   * @note Intended to be used in expressions by `decltype(<actuator instance>.type()`
-   *
-   * @return actionT
+   * @param element - Callable returning the name, as a std::string_view, and the action of a range position.
    */
-  actionT type()
+  template<typename iteratorT, typename elementT>
+  void insertSorted(mapActionsT& named, iteratorT first, iteratorT last, elementT&& element)
   {
-    return nullptr;
+    const nameT front(element(*first).first, typename nameT::allocator_type(get_allocator()));
+    auto hint = named.lower_bound(front);
+    for (; first != last; ++first)
+    {
+      const auto [name, action] = element(*first);
+      hint = named.emplace_hint(hint, name, action);
+      ++hint;
+    }
   }
 
   /**
-   * @brief Assignment operator.
+   * @brief Remove a named action.
    *
-   * Example:
-   * \snippet test_actuator.cpp test_assignment
    */
-  actuator& operator=(const actuator& other)
+  void eraseName(const std::string& name)
   {
-    actions.clear();
-    mapActions.clear();
-    actions = other.actions;
-    mapActions = other.mapActions;
-    return *this;
+    auto& named = mutableMapActions();
+    const auto it = named.find(name);
+    if (it != named.end())
+    {
+      forgetHot(&*it);
+      named.erase(it);
+    }
   }
 
-  void reset()
+  /**
+   * @brief Remove a named action found invalid by an invocation, without changing the revision.
+   *
+   */
+  void eraseInvalidName(const std::string& name)
   {
-    actions.reset();
+    auto& table = ownTable();
+    if (!table.mapActions)
+    {
+      return;
+    }
+    const auto it = table.mapActions->find(name);
+    if (it != table.mapActions->end() && !*it->second)
+    {
+      forgetHot(&*it);
+      table.mapActions->erase(it);
+    }
   }
 
   /**
-   * @brief The call operator.
-   *
-   * Actions in the actuator#actions list are triggered by invoking the call operator.
+   * @brief Invoke the actions of a table.
    *
-   * @param args - Arguments list must match the action arity.
+   * @return true - if empty actions were found, to be removed once the table is released.
    */
   template<typename ...Args>
-  void operator()(Args&&... args)
+  bool dispatch(const action_table& table, Args&&... args)
   {
-    results.clear();
-    for (const auto& action : actions)
+    bool hasEmptyActions = false;
+    for (const auto& action : table.actions)
     {
-      if (action)
+      if (action && *action)
       {
-        try
-        {
-          // todo: to be removed?
-          // with SFINAE
-          // select_actuate(action, std::forward<Args>(args)...);
-
-          if constexpr (std::is_same_v<typename actionT::result_type, void>) {
-            (*action)(std::forward<Args>(args)...);
-          } else {
-            results.push_back((*action)(std::forward<Args>(args)...));
-          }
-        }
-        catch (const invalid_action& ia)
-        {
-          std::cout << ia.what.c_str() << std::endl;
-          *action = nullptr;
-        }
+        UNTANGLE_TRACE_SCOPE(this, action, "operator()", 10);
+        hasEmptyActions |= !actuate(action, args...);
+      }
+      else
+      {
+        hasEmptyActions = true;
       }
     }
-    actions.remove_if([](const auto& action)
-    {
-      return (*action == nullptr);
-    });
+    return hasEmptyActions;
   }
 
   /**
-   * @brief Invokes one single action associated with a key.
+   * @brief A valid named action of a table, or null.
    *
-   * @param name - Key associated with the action.
-   * @param args - Arguments list must match the action arity.
    */
-  template<typename ...Args>
-  void invokeAction(std::string name, Args&&... args)
+  static actionT* findNamed(const action_table* table, const std::string& name)
   {
-    results.clear();
-    const auto& it = mapActions.find(name);
-    if (it != mapActions.end())
+    if (!table || !table->mapActions)
     {
-      try
+      return nullptr;
+    }
+    actionT* action = nullptr;
+    if (table->hits)
+    {
+      const auto hash = hit_tracker::hash(name);
+      if (const auto* element = table->hits->find(hash, name))
+      {
+        action = element->second;
+      }
+      else
       {
-        select_actuate(it->second, std::forward<Args>(args)...);
+        const auto it = table->mapActions->find(name);
+        action = it != table->mapActions->end() ? it->second : nullptr;
       }
-      catch (const invalid_action& ia)
+      if (action)
       {
-        std::cout << ia.what.c_str() << std::endl;
-        mapActions.erase(name);
+        table->hits->count(hash);
       }
     }
+    else
+    {
+      const auto it = table->mapActions->find(name);
+      action = it != table->mapActions->end() ? it->second : nullptr;
+    }
+    return action && *action ? action : nullptr;
   }
 
   /**
-   * @brief Add an action to the actions list.
-   *
-   * @param action - Action to be added.
+   * @brief Drop a named action from the hot cache, before erasing it from the map.
    *
-   * Example:
-   * \snippet test_actuator.cpp test_add
    */
-  void add(actionT* action)
+  void forgetHot(const typename mapActionsT::value_type* element)
   {
-    actions.push_back(action);
+    if (actionTable->hits)
+    {
+      actionTable->hits->forget(element);
+    }
   }
 
   /**
-   * @brief Add action to the actions map associated with a name.
+   * @brief The valid named actions of a table, for a list of names; null for the names not found.
    *
-   * @param name - Name of the action.
-   * @param action - Action to be added.
    */
-  void add(std::string name, actionT* action)
+  static std::vector<actionT*> resolveNames(const action_table* table, const std::vector<const std::string*>& names)
   {
-    mapActions.emplace(name, action);
+    std::vector<actionT*> resolved(names.size(), nullptr);
+    if (!table || !table->mapActions || names.empty())
+    {
+      return resolved;
+    }
+    const auto& named = *table->mapActions;
+    std::size_t depth = 1;
+    while ((std::size_t(1) << depth) < named.size())
+    {
+      ++depth;
+    }
+    if (names.size() * depth < named.size())
+    {
+      // a few names: one lookup each is cheaper than walking the map
+      for (std::size_t i = 0; i < names.size(); ++i)
+      {
+        resolved[i] = findNamed(table, *names[i]);
+      }
+      return resolved;
+    }
+    std::vector<std::size_t> order(names.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+      order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&names](std::size_t a, std::size_t b) { return *names[a] < *names[b]; });
+    const auto less = named.key_comp();
+    auto it = named.begin();
+    for (const auto i : order)
+    {
+      while (it != named.end() && less(it->first, *names[i]))
+      {
+        ++it;
+      }
+      if (it != named.end() && !less(*names[i], it->first) && it->second && *it->second)
+      {
+        resolved[i] = it->second;
+        if (table->hits)
+        {
+          table->hits->count(hit_tracker::hash(*names[i]));
+        }
+      }
+    }
+    return resolved;
   }
 
   /**
-   * @brief Remove an action from the actions list.
-   *
-   * An invalid action (empty std::function) is implicitly removed when operator()() is invoked.
-   *
-   * @param action - Action to be removed.
+   * @brief Invoke a named action; an invalid one is left to the caller to remove, see \ref eraseInvalidName().
    *
-   * Example:
-   * \snippet test_actuator.cpp test_add
    */
-  void remove(const actionT* action)
+  template<typename ...Args>
+  action_status invokeNamed(actionT* action, [[maybe_unused]] const std::string& name, Args&&... args)
   {
-    actions.remove_if([&action](const auto& a)
+    bool invoked;
     {
-      return (action == a);
-    });
+      UNTANGLE_TRACE_SCOPE(this, action, name.data(), name.size());
+      invoked = actuate(action, std::forward<Args>(args)...);
+    }
+    if (!invoked)
+    {
+      return action_status::invalid;
+    }
+    return action_status::invoked;
   }
 
   /**
-   * @brief Remove an action from actions map.
+   * @brief Remove the empty actions, left by invalid actions, without changing the revision.
    *
-   * @param name -  Name of the action to remove.
+   * The table is modified in place, unless it is shared with other actuators.
    */
-  void remove(const std::string& name)
+  void eraseEmptyActions()
   {
-    mapActions.erase(name);
+    ownTable().erase_if([](const auto& action)
+    {
+      return (action == nullptr || *action == nullptr);
+    });
   }
 
   /**
-   * @brief Check if this actuator is "connected" with other actions.
+   * @brief Invoke one action, storing its result.
    *
-   * @return true - if the actuator::actions list is not empty.
-   * @return false - if the actuator::actions list is empty.
+   * @return true - if the action was invoked.
+   * @return false - if the action is an invalid binding (see \ref bind()); an empty action is left in its place.
    */
-  bool is_connected() { return !actions.empty() || !mapActions.empty(); }
+  template<typename ...Args>
+  bool actuate(actionT* action, Args&&... args)
+  {
+    [[maybe_unused]] const auto count = results.size();
+    if (detail::guard_action([&]() { select_actuate(action, std::forward<Args>(args)...); }))
+    {
+      return true;
+    }
+    if constexpr (!std::is_void_v<typename actionT::result_type>)
+    {
+      // without exceptions, the default result of the invalid action was stored
+      if (results.size() > count)
+      {
+        results.pop_back();
+      }
+    }
+    *action = nullptr;
+    return false;
+  }
 
   /**
-   * @brief Check if there is certain named action.
+   * @brief The named actions map, ready to be modified.
    *
-   * @param name - Name associated with the action.
-   * @return true - if name can be found in actuator::mapActions
-   * @return false - if name can not be found in actuator::mapActions
    */
-  bool has_action(std::string name) { return mapActions.find(name) != mapActions.end(); }
+  mapActionsT& mutableMapActions()
+  {
+    auto& table = mutableTable();
+    if (!table.mapActions)
+    {
+      table.mapActions.emplace(table.actions.get_allocator());
+    }
+    return *table.mapActions;
+  }
 
-  private:
    /**
    * @brief SFINAE for void return.
    *
@@ -266,6 +1991,29 @@ struct actuator final
   }
 };
 
+// layout: an actuator is a single pointer to its action table, plus the results vector for non-void actions
+static_assert(sizeof(actuator<std::function<void(int)>>) == sizeof(void*),
+              "an actuator of void actions must be the size of a pointer");
+static_assert(sizeof(actuator<std::function<int()>>) == sizeof(void*) + sizeof(std::vector<int>),
+              "an actuator of non-void actions must be the size of a pointer and a results vector");
+
+#if __has_include(<memory_resource>)
+namespace pmr
+{
+/**
+ * @brief An actuator whose action table, named actions and results are allocated from a std::pmr::memory_resource.
+ *
+ * Example:
+ * `std::pmr::monotonic_buffer_resource arena; untangle::pmr::actuator<std::function<void(int)>> a(&arena);`
+ */
+template<typename actionT>
+using actuator = untangle::actuator<actionT, std::pmr::polymorphic_allocator<actionT*>>;
+}
+
+static_assert(sizeof(pmr::actuator<std::function<void(int)>>) == 2 * sizeof(void*),
+              "a pmr actuator of void actions must be the size of a pointer and a memory resource pointer");
+#endif
+
 /**
  * @brief Creates an actuator holding an initial list of actions.
  *
@@ -283,40 +2031,30 @@ template<typename actionT, typename ...Actions>
 auto connect(actionT& A1, Actions&... An)
 {
   using actuatorT = untangle::actuator<actionT>;
-  actuatorT actuator;
-  actuator.actions = {&A1, &An...};
+  typename actuatorT::actionsT actions = {&A1, &An...};
 
   // remove empty actions
-  actuator.actions.remove_if([](const auto& action)
+  actions.erase(std::remove_if(actions.begin(), actions.end(), [](const auto& action)
   {
     return (*action == nullptr);
-  });
-  return std::move(actuator);
+  }), actions.end());
+  return actuatorT(std::move(actions));
 }
 
 template <typename actuatorT>
 void removeEmptyActions(actuatorT& actuator)
 {
-  std::vector<typename actuatorT::mapActionsT::const_iterator> removableIterators;
-  for (auto it = actuator.mapActions.begin(); it != actuator.mapActions.end(); ++it)
-  {
-    if (it->second == nullptr)
-    {
-      removableIterators.push_back(it);
-    }
-  }
-  for (auto it: removableIterators)
+  actuator.remove_named_if([](const auto&, const auto* action)
   {
-    actuator.mapActions.erase(it);
-  }
+    return action == nullptr;
+  });
 }
 
 template<typename keyT, typename actionT, typename ...Actions>
 auto connect(std::pair<keyT, actionT*> A1, Actions... An)
 {
   using actuatorT = untangle::actuator<actionT>;
-  actuatorT actuator;
-  actuator.mapActions = {A1, An...};
+  actuatorT actuator(typename actuatorT::mapActionsT{A1, An...});
 
   // remove empty actions
   removeEmptyActions(actuator);
@@ -340,6 +2078,49 @@ struct function_remove_const<R(Args...)const>
     using type = R(Args...);
 };
 
+/**
+ * @brief Argument types of an action, as values: the arguments stored by the recorder, or by the memoization cache.
+ *
+ */
+template<typename actionT>
+struct action_arguments;
+
+template<typename R, typename ...Args>
+struct action_arguments<std::function<R(Args...)>>
+{
+  using type = std::tuple<std::decay_t<Args>...>;
+};
+
+// function type of an action
+template <typename actionT>
+struct function_signature;
+
+template <typename R, typename... Args>
+struct function_signature<std::function<R(Args...)>>
+{
+    using type = R(Args...);
+};
+
+// class, result and arguments of a pointer to function member
+template <typename T>
+struct member_function_traits;
+
+template <typename R, typename C, typename... Args>
+struct member_function_traits<R (C::*)(Args...)>
+{
+    using class_type = C;
+    using result_type = R;
+    using function_type = R(Args...);
+};
+
+template <typename R, typename C, typename... Args>
+struct member_function_traits<R (C::*)(Args...) const>
+{
+    using class_type = const C;
+    using result_type = R;
+    using function_type = R(Args...);
+};
+
 /**
  *  @defgroup untangle_functions namespace untangle: functions
  */
@@ -357,6 +2138,8 @@ struct function_remove_const<R(Args...)const>
  * @return actionT - A std::function that wraps the pointer to function member.
  *
  * @remark If the class object gets invalid, invoking this binding will throw an exception of type invalid_action.
+ * Without exceptions (see UNTANGLE_EXCEPTIONS), it returns a default constructed result instead, and the actuator
+ * removes it the same way.
  *
  * @ingroup untangle_functions
  */
@@ -372,7 +2155,7 @@ static actionT bind(const std::shared_ptr<classT>& obj, T classT::* method)
     else
     {
       //inform the actuator about dead binding
-      throw invalid_action("bind::method: invalid object");
+      return detail::invalid_action_result<typename actionT::result_type>("bind::method: invalid object");
     }
   };
 }
@@ -400,4 +2183,166 @@ static actionT bind(classT* obj, T classT::* method)
   };
 }
 
+/**
+ * @brief Callable invoking a function member known at compile time, returned by bind<method>().
+ *
+ * It holds one pointer: it is stored inline by std::function, and its call target can be inlined.
+ *
+ * @tparam method Pointer to function member.
+ * @tparam pointerT std::shared_ptr<classT>, referred to and checked at each call like bind(obj, method),
+ * or classT*, not checked.
+ */
+template <auto method, typename pointerT,
+          typename functionT = typename member_function_traits<decltype(method)>::function_type>
+struct method_binding;
+
+template <auto method, typename pointerT, typename R, typename... Args>
+struct method_binding<method, pointerT, R(Args...)>
+{
+  using result_type = R;
+
+  R operator()(Args... args) const
+  {
+    if constexpr (std::is_pointer_v<pointerT>)
+    {
+      return (obj->*method)(std::forward<Args>(args)...);
+    }
+    else
+    {
+      if (*obj)
+      {
+        return ((**obj).*method)(std::forward<Args>(args)...);
+      }
+      //inform the actuator about dead binding
+      return detail::invalid_action_result<R>("bind::method: invalid object");
+    }
+  }
+
+  std::conditional_t<std::is_pointer_v<pointerT>, pointerT, const pointerT*> obj; //!< The class object.
+};
+
+/**
+ * @brief Binding to a class function member, given as a template argument.
+ *
+ * Same as bind(obj, method), but the call target is known at compile time and the binding is the size of a pointer.
+ *
+ * @param obj - Class object. It is referred to by the binding, and must outlive it.
+ * @return A \ref method_binding, to be stored in an action (std::function).
+ *
+ * Example: `std::function<void(int)> action = untangle::bind<&triangle::rotate>(t);`
+ *
+ * @ingroup untangle_functions
+ */
+template <auto method, typename classT>
+static method_binding<method, std::shared_ptr<classT>> bind(const std::shared_ptr<classT>& obj)
+{
+  static_assert(std::is_base_of_v<std::remove_const_t<typename member_function_traits<decltype(method)>::class_type>,
+                                  classT>, "the method must be a member of the class");
+  return {&obj};
+}
+
+/**
+ * @brief Binding to a class method, given as a template argument, through a pointer.
+ *
+ * @attention As bind(classT*, method), it can not check if the object gets invalid.
+ *
+ * @ingroup untangle_functions
+ */
+template <auto method, typename classT>
+static method_binding<method, classT*> bind(classT* obj)
+{
+  assert(obj != nullptr);
+  return {obj};
+}
+
+/**
+ * @brief Callable adapting another callable to the signature of an action, returned by adapt().
+ *
+ * The call is resolved at compile time: the bound arguments are passed first, followed by as many leading action
+ * arguments as the callable accepts, the others being dropped; the result is discarded if the action returns void.
+ *
+ * @tparam functionT Action function type, R(Args...).
+ * @tparam callableT Adapted callable: function object, pointer to function, or pointer to member with the object
+ * given as the first bound argument.
+ * @tparam Bound Bound argument types, stored by value.
+ */
+template <typename functionT, typename callableT, typename... Bound>
+struct action_adapter;
+
+template <typename R, typename... Args, typename callableT, typename... Bound>
+struct action_adapter<R(Args...), callableT, Bound...>
+{
+  using result_type = R;
+
+  R operator()(Args... args)
+  {
+    static_assert(arity() <= sizeof...(Args), "the callable does not accept the bound arguments and a prefix of the action arguments");
+    return call(std::make_index_sequence<sizeof...(Bound)>(), std::make_index_sequence<arity()>(),
+                std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  callableT callable; //!< Adapted callable.
+  std::tuple<Bound...> bound; //!< Arguments passed first.
+
+  private:
+  /**
+   * @brief Number of leading action arguments passed to the callable: the most it accepts.
+   *
+   */
+  static constexpr std::size_t arity()
+  {
+    return longest_prefix(std::make_index_sequence<sizeof...(Args) + 1>());
+  }
+
+  template <std::size_t... N>
+  static constexpr std::size_t longest_prefix(std::index_sequence<N...>)
+  {
+    std::size_t longest = sizeof...(Args) + 1;
+    ((longest = accepts<N>(std::make_index_sequence<N>()) ? N : longest), ...);
+    return longest;
+  }
+
+  template <std::size_t N, std::size_t... I>
+  static constexpr bool accepts(std::index_sequence<I...>)
+  {
+    return std::is_invocable_v<callableT&, Bound&..., std::tuple_element_t<I, std::tuple<Args&&...>>...>;
+  }
+
+  template <std::size_t... B, std::size_t... I>
+  R call(std::index_sequence<B...>, std::index_sequence<I...>, std::tuple<Args&&...> arguments)
+  {
+    if constexpr (std::is_void_v<R>)
+    {
+      std::invoke(callable, std::get<B>(bound)..., std::get<I>(std::move(arguments))...);
+    }
+    else
+    {
+      return std::invoke(callable, std::get<B>(bound)..., std::get<I>(std::move(arguments))...);
+    }
+  }
+};
+
+/**
+ * @brief Adapt a callable of a compatible signature to an action, in a single callable.
+ *
+ * Wrapping a lambda that adapts the call into the action std::function adds a second type-erased call; the adapter
+ * is resolved at compile time instead, and an adapter of a pointer to function, without bound arguments, is stored
+ * by std::function without allocation.
+ *
+ * @param callable - Callable taking the bound arguments, then a prefix of the action arguments.
+ * @param bound - Arguments passed first, copied into the adapter.
+ * @return An \ref action_adapter, to be stored in an action.
+ *
+ * Example: `std::function<void(int)> action = untangle::adapt<std::function<void(int)>>(&move_to, 0);` invokes
+ * `move_to(0, x)` and discards its result.
+ *
+ * @ingroup untangle_functions
+ */
+template <typename actionT, typename callableT, typename... Bound>
+static action_adapter<typename function_signature<actionT>::type, std::decay_t<callableT>, std::decay_t<Bound>...>
+adapt(callableT&& callable, Bound&&... bound)
+{
+  return {std::forward<callableT>(callable), {std::forward<Bound>(bound)...}};
+}
+
 }
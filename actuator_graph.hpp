@@ -0,0 +1,313 @@
+/**
+ * @brief Dataflow graph of \ref untangle::actuator nodes.
+ *
+ * @file actuator_graph.hpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark Actuators wired into each other form a DAG, where a single input may reach the same downstream actuator
+ * through several paths. Instead of having actions emit the downstream actuators directly, the connections are
+ * declared to a \ref untangle::graph: a change marks a node dirty, and \ref untangle::graph::propagate() invokes
+ * every affected actuator exactly once, in topological order, after all its inputs are up to date.
+ */
+#pragma once
+
+#include "actuator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace untangle
+{
+/**
+ * @brief A DAG of actuators, updated once per node in topological order.
+ *
+ * Nodes are actuators invoked without arguments: their actions read their inputs from the objects they are bound
+ * to. A node is either:
+ * - eager: invoked by \ref propagate() when one of its inputs changed;
+ * - lazy: only marked stale by \ref propagate(), and recomputed by \ref refresh() when its results are needed.
+ *   It is intended for actuators with non-void results.
+ *
+ * The actuators must outlive the graph.
+ */
+struct graph
+{
+  using node = std::size_t;
+
+  /**
+   * @brief Add an eager node.
+   *
+   * @param actuator - Actuator invoked when the node is updated.
+   * @return The node.
+   */
+  template<typename actuatorT>
+  node add(actuatorT& actuator)
+  {
+    return add_node(actuator, false);
+  }
+
+  /**
+   * @brief Add a lazy node.
+   *
+   * @param actuator - Actuator invoked when the node is refreshed.
+   * @return The node.
+   */
+  template<typename actuatorT>
+  node add_lazy(actuatorT& actuator)
+  {
+    return add_node(actuator, true);
+  }
+
+  /**
+   * @brief Connect the output of a node to the input of another.
+   *
+   * @param from - Upstream node.
+   * @param to - Downstream node.
+   * @return true - if the nodes are connected.
+   * @return false - if the connection would create a cycle.
+   */
+  bool connect(node from, node to)
+  {
+    assert(from < nodes.size() && to < nodes.size());
+    if (from == to || reaches(to, from))
+    {
+      return false;
+    }
+    nodes[from].successors.push_back(to);
+    nodes[to].predecessors.push_back(from);
+    orderValid = false;
+    return true;
+  }
+
+  /**
+   * @brief Remove a connection added by \ref connect().
+   *
+   */
+  void disconnect(node from, node to)
+  {
+    assert(from < nodes.size() && to < nodes.size());
+    auto& successors = nodes[from].successors;
+    const auto it = std::find(successors.begin(), successors.end(), to);
+    if (it != successors.end())
+    {
+      successors.erase(it);
+      auto& predecessors = nodes[to].predecessors;
+      predecessors.erase(std::find(predecessors.begin(), predecessors.end(), from));
+      orderValid = false;
+    }
+  }
+
+  /**
+   * @brief Notify that the inputs of a node changed.
+   *
+   * @param n - Changed node. It is updated, with its successors, by the next \ref propagate().
+   */
+  void mark_dirty(node n)
+  {
+    assert(n < nodes.size());
+    sort();
+    enqueue(n);
+  }
+
+  /**
+   * @brief Update the dirty nodes and all the nodes downstream of them.
+   *
+   * Each affected eager node is invoked once, after all its affected inputs; lazy nodes are marked stale, and
+   * refreshed only if an eager node downstream is invoked.
+   *
+   * @return The number of eager nodes invoked.
+   */
+  std::size_t propagate()
+  {
+    sort();
+    std::size_t invoked = 0;
+    while (!pending.empty())
+    {
+      const node n = order[pending.top()];
+      pending.pop();
+      auto& current = nodes[n];
+      current.queued = false;
+      if (current.lazy)
+      {
+        current.stale = true;
+      }
+      else
+      {
+        for (const auto predecessor : current.predecessors)
+        {
+          refresh(predecessor);
+        }
+        current.invoke();
+        ++invoked;
+      }
+      for (const auto successor : current.successors)
+      {
+        enqueue(successor);
+      }
+    }
+    return invoked;
+  }
+
+  /**
+   * @brief Recompute a lazy node if its inputs changed since it was last computed.
+   *
+   * The stale lazy nodes upstream are refreshed first.
+   *
+   * @param n - Node to refresh.
+   * @return true - if the node actuator was invoked.
+   * @return false - if the node was up to date.
+   */
+  bool refresh(node n)
+  {
+    assert(n < nodes.size());
+    auto& current = nodes[n];
+    if (!current.stale)
+    {
+      return false;
+    }
+    for (const auto predecessor : current.predecessors)
+    {
+      refresh(predecessor);
+    }
+    current.invoke();
+    current.stale = false;
+    return true;
+  }
+
+  /**
+   * @brief Check if a node has pending changes.
+   *
+   * @return true - if an eager node waits for \ref propagate(), or a lazy node waits for \ref refresh().
+   */
+  bool is_dirty(node n) const
+  {
+    assert(n < nodes.size());
+    return nodes[n].queued || nodes[n].stale;
+  }
+
+  /**
+   * @brief Number of nodes.
+   *
+   */
+  std::size_t size() const { return nodes.size(); }
+
+  private:
+  struct node_state
+  {
+    std::function<void()> invoke; //!< Invokes the node actuator.
+    std::vector<node> successors; //!< Downstream nodes.
+    std::vector<node> predecessors; //!< Upstream nodes.
+    std::size_t rank = 0; //!< Position in the topological order.
+    bool lazy = false;
+    bool queued = false; //!< Waits in the pending queue.
+    bool stale = true; //!< Lazy node not computed since its inputs changed.
+  };
+
+  std::vector<node_state> nodes;
+  std::vector<node> order; //!< Nodes in topological order.
+  bool orderValid = true;
+  std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> pending; //!< Ranks of the dirty nodes.
+
+  template<typename actuatorT>
+  node add_node(actuatorT& actuator, bool lazy)
+  {
+    node_state state;
+    state.invoke = [&actuator]() { actuator(); };
+    state.lazy = lazy;
+    state.stale = lazy;
+    state.rank = nodes.size();
+    nodes.push_back(std::move(state));
+    order.push_back(nodes.size() - 1);
+    return nodes.size() - 1;
+  }
+
+  void enqueue(node n)
+  {
+    auto& state = nodes[n];
+    if (!state.queued)
+    {
+      state.queued = true;
+      pending.push(state.rank);
+    }
+  }
+
+  /**
+   * @brief Check if there is a path between two nodes.
+   *
+   */
+  bool reaches(node from, node to) const
+  {
+    std::vector<node> stack{from};
+    std::vector<bool> visited(nodes.size(), false);
+    while (!stack.empty())
+    {
+      const node n = stack.back();
+      stack.pop_back();
+      if (n == to)
+      {
+        return true;
+      }
+      if (!visited[n])
+      {
+        visited[n] = true;
+        stack.insert(stack.end(), nodes[n].successors.begin(), nodes[n].successors.end());
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Recompute the topological order after the connections changed (Kahn's algorithm).
+   *
+   */
+  void sort()
+  {
+    if (orderValid)
+    {
+      return;
+    }
+    // the queued ranks refer to the previous order
+    std::vector<node> queued;
+    while (!pending.empty())
+    {
+      queued.push_back(order[pending.top()]);
+      pending.pop();
+    }
+
+    std::vector<std::size_t> inputs(nodes.size());
+    order.clear();
+    for (node n = 0; n < nodes.size(); ++n)
+    {
+      inputs[n] = nodes[n].predecessors.size();
+      if (inputs[n] == 0)
+      {
+        order.push_back(n);
+      }
+    }
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+      for (const auto successor : nodes[order[i]].successors)
+      {
+        if (--inputs[successor] == 0)
+        {
+          order.push_back(successor);
+        }
+      }
+    }
+    assert(order.size() == nodes.size());
+    for (std::size_t rank = 0; rank < order.size(); ++rank)
+    {
+      nodes[order[rank]].rank = rank;
+    }
+    orderValid = true;
+    for (const auto n : queued)
+    {
+      pending.push(nodes[n].rank);
+    }
+  }
+};
+
+}
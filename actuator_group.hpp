@@ -0,0 +1,130 @@
+/**
+ * @brief Groups of objects sharing one action method, invoked as a single \ref untangle::actuator action.
+ *
+ * @file actuator_group.hpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark Connecting `bind(t1, &triangle::rotate)`, `bind(t2, &triangle::rotate)`, ... costs one std::function
+ * call and one pointer to member call per object. A \ref untangle::method_group holds the objects in a contiguous
+ * array and calls the method, known at compile time, in a tight loop: the whole group is one action of the actuator.
+ */
+#pragma once
+
+#include "actuator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace untangle
+{
+namespace detail
+{
+/**
+ * @brief Hint the processor to load the cache line of an address.
+ *
+ */
+inline void prefetch(const void* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#else
+  (void)address;
+#endif
+}
+} // namespace detail
+
+/**
+ * @brief Objects whose same function member is invoked with the same arguments.
+ *
+ * @attention The objects are referred through raw pointers, as by bind(classT*, method): they must be removed from
+ * the group before being destroyed.
+ *
+ * @remark The method is called through the class of the group: declare the class, or the method, final for the
+ * compiler to devirtualize and inline the call.
+ *
+ * @tparam method Pointer to function member, specified as &<class type>::<function member>. It must return void.
+ */
+template<auto method, typename functionT = typename member_function_traits<decltype(method)>::function_type>
+struct method_group;
+
+template<auto method, typename R, typename ...Args>
+struct method_group<method, R(Args...)>
+{
+  static_assert(std::is_void_v<R>, "the method of a group must return void");
+
+  using classT = typename member_function_traits<decltype(method)>::class_type;
+  using actionT = std::function<void(Args...)>;
+
+  /**
+   * @brief Add an object to the group.
+   *
+   */
+  void add(classT* obj)
+  {
+    assert(obj != nullptr);
+    objects.push_back(obj);
+  }
+
+  /**
+   * @brief Remove an object from the group.
+   *
+   * @return true - if the object was in the group.
+   */
+  bool remove(const classT* obj)
+  {
+    const auto it = std::find(objects.begin(), objects.end(), obj);
+    if (it == objects.end())
+    {
+      return false;
+    }
+    objects.erase(it);
+    return true;
+  }
+
+  void reserve(std::size_t count) { objects.reserve(count); }
+
+  void clear() { objects.clear(); }
+
+  std::size_t size() const { return objects.size(); }
+
+  bool empty() const { return objects.empty(); }
+
+  /**
+   * @brief Invoke the method of all the objects, in the order they were added.
+   *
+   */
+  void operator()(Args... args) const
+  {
+    const auto count = objects.size();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      if (i + prefetchDistance < count)
+      {
+        detail::prefetch(objects[i + prefetchDistance]);
+      }
+      (objects[i]->*method)(args...);
+    }
+  }
+
+  /**
+   * @brief An action invoking the group, to be added to an \ref actuator.
+   *
+   * @remark It refers to the group, that must outlive it.
+   */
+  actionT action() const
+  {
+    return [this](Args... args) { (*this)(args...); };
+  }
+
+  private:
+  static constexpr std::size_t prefetchDistance = 8; //!< Objects loaded ahead of the current one.
+
+  std::vector<classT*> objects;
+};
+
+}
@@ -0,0 +1,368 @@
+/**
+ * @brief Cross-process emission of \ref untangle::actuator actions, over a shared-memory ring.
+ *
+ * @file actuator_ipc.hpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark A publisher process emits through an \ref untangle::ipc_ring: the arguments, that must be trivially
+ * copyable and cannot be pointers, are copied into a fixed-size record of a ring in POSIX shared memory (shm_open,
+ * mmap). Subscriber processes open the same ring and \ref untangle::ipc_ring::poll() it, dispatching the records
+ * to their local actuators. There is no lock and no system call on either side: the publisher never waits, and a
+ * subscriber too slow to keep up skips the records overwritten in the meantime, and counts them as lost.
+ * This header is POSIX-only.
+ */
+#pragma once
+
+#include "actuator.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace untangle
+{
+namespace detail
+{
+/**
+ * @brief Layout of the arguments of an action in a record: their bytes, one after another.
+ *
+ */
+template<typename ...Args>
+struct packed_arguments
+{
+  static_assert((std::is_trivially_copyable_v<Args> && ...), "the arguments sent across processes must be trivially copyable");
+  // an address is meaningless in the other processes
+  static_assert(!(std::is_pointer_v<Args> || ...), "the arguments sent across processes cannot be pointers");
+
+  static constexpr std::size_t size = (sizeof(Args) + ... + 0);
+
+  static void write(char* out, const Args&... args)
+  {
+    ((std::memcpy(out, &args, sizeof(Args)), out += sizeof(Args)), ...);
+  }
+
+  static std::tuple<Args...> read(const char* in)
+  {
+    // braced initialization evaluates the elements in order
+    return std::tuple<Args...>{read_one<Args>(in)...};
+  }
+
+  private:
+  template<typename T>
+  static T read_one(const char*& in)
+  {
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+    return value;
+  }
+};
+
+template<typename actionT>
+struct ipc_arguments;
+
+template<typename R, typename ...Args>
+struct ipc_arguments<std::function<R(Args...)>>
+{
+  using type = packed_arguments<std::decay_t<Args>...>;
+};
+
+/**
+ * @brief Shared ring header, at the beginning of the shared memory.
+ *
+ */
+struct ring_header
+{
+  static constexpr char magicValue[8] = {'U', 'N', 'T', 'G', 'R', 'N', 'G', '1'};
+
+  char magic[8]; //!< Ring marker, written last on creation.
+  std::uint32_t recordSize; //!< Bytes of arguments per record, checked on open.
+  std::uint32_t capacity; //!< Number of records, a power of 2.
+  alignas(64) std::atomic<std::uint64_t> head; //!< Sequence number of the last published record, 0 if none.
+};
+
+/**
+ * @brief Record header, followed by the arguments.
+ *
+ * @remark The sequence is a seqlock: 0 while the record is written, then the sequence number of the record.
+ */
+struct ring_record
+{
+  std::atomic<std::uint64_t> sequence;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "the shared ring needs lock-free 64 bits atomics");
+
+/**
+ * @brief Bytes per record of a ring, a multiple of the cache line.
+ *
+ */
+template<typename argumentsT>
+constexpr std::size_t ring_stride = (sizeof(ring_record) + argumentsT::size + 63) & ~std::size_t(63);
+
+/**
+ * @brief Offset of a record from the beginning of the shared memory; the offset of the record `capacity` is the
+ * size of the ring.
+ *
+ */
+template<typename argumentsT>
+constexpr std::size_t ring_record_offset(std::size_t index)
+{
+  return sizeof(ring_header) + index * ring_stride<argumentsT>;
+}
+} // namespace detail
+
+/**
+ * @brief A ring of emissions in shared memory, written by one publisher and read by any number of subscribers.
+ *
+ * The publisher creates the ring, the subscribers open it by name; each process uses its own ring object.
+ * A subscriber reads the records in order, from the oldest one still in the ring when it opened it.
+ *
+ * @attention There must be a single publisher at a time; a ring object must be used from one thread at a time.
+ *
+ * @tparam actionT Action type of the subscriber actuators, specified as std::function<...>.
+ */
+template<typename actionT>
+struct ipc_ring
+{
+  using argumentsT = typename detail::ipc_arguments<actionT>::type;
+
+  ipc_ring() = default;
+  ipc_ring(const ipc_ring&) = delete;
+  ipc_ring& operator=(const ipc_ring&) = delete;
+  ~ipc_ring()
+  {
+    close();
+  }
+
+  /**
+   * @brief Create, or reset, a shared ring, as its publisher.
+   *
+   * A ring of the same name is unlinked and replaced by a new one, so that the mapping of its subscribers is never
+   * truncated under them: they keep reading the former ring, and must open the name again to follow the new one.
+   *
+   * @param name - Shared memory name, like "/my_ring".
+   * @param capacity - Number of records, rounded up to a power of 2.
+   * @return true - if the ring is ready.
+   * @return false - if the shared memory could not be created or mapped.
+   */
+  bool create(const std::string& name, std::size_t capacity = 1024)
+  {
+    close();
+    std::size_t records = 1;
+    while (records < capacity)
+    {
+      records *= 2;
+    }
+    ::shm_unlink(name.c_str());
+    const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+    {
+      return false;
+    }
+    const auto bytes = detail::ring_record_offset<argumentsT>(records);
+    const bool mapped = ::ftruncate(fd, static_cast<off_t>(bytes)) == 0 && map(fd, bytes);
+    ::close(fd);
+    if (!mapped)
+    {
+      return false;
+    }
+    // the new shared memory is zero-filled: the atomics are constructed in it, the magic is left cleared
+    header->recordSize = static_cast<std::uint32_t>(argumentsT::size);
+    header->capacity = static_cast<std::uint32_t>(records);
+    new (&header->head) std::atomic<std::uint64_t>(0);
+    for (std::size_t i = 0; i < records; ++i)
+    {
+      new (&record(i).sequence) std::atomic<std::uint64_t>(0);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, detail::ring_header::magicValue, sizeof(header->magic));
+    mask = records - 1;
+    next = 1;
+    return true;
+  }
+
+  /**
+   * @brief Open a shared ring created by the publisher, as a subscriber.
+   *
+   * @param name - Shared memory name.
+   * @return true - if the ring is open.
+   * @return false - if there is no such ring, or its records do not match the action arguments.
+   */
+  bool open(const std::string& name)
+  {
+    close();
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+    {
+      return false;
+    }
+    struct stat st{};
+    const bool mapped = ::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(detail::ring_header) &&
+                        map(fd, static_cast<std::size_t>(st.st_size));
+    ::close(fd);
+    if (!mapped)
+    {
+      return false;
+    }
+    const auto records = static_cast<std::size_t>(header->capacity);
+    if (std::memcmp(header->magic, detail::ring_header::magicValue, sizeof(header->magic)) != 0 ||
+        header->recordSize != argumentsT::size || records == 0 || (records & (records - 1)) != 0 ||
+        size < detail::ring_record_offset<argumentsT>(records))
+    {
+      close();
+      return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    mask = records - 1;
+    const auto published = header->head.load(std::memory_order_acquire);
+    next = published >= records ? published - records + 1 : 1;
+    return true;
+  }
+
+  void close()
+  {
+    if (header)
+    {
+      ::munmap(header, size);
+      header = nullptr;
+    }
+    size = 0;
+    lostRecords = 0;
+  }
+
+  /**
+   * @brief Remove a shared ring name; the processes that opened it keep their mapping.
+   *
+   */
+  static bool unlink(const std::string& name)
+  {
+    return ::shm_unlink(name.c_str()) == 0;
+  }
+
+  bool is_open() const { return header != nullptr; }
+
+  /**
+   * @brief Publish an emission.
+   *
+   * @param args - Arguments of the subscriber actions.
+   */
+  template<typename ...Args>
+  void operator()(const Args&... args)
+  {
+    assert(header != nullptr);
+    auto& r = record(next & mask);
+    r.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    write(reinterpret_cast<char*>(&r + 1), args...);
+    r.sequence.store(next, std::memory_order_release);
+    header->head.store(next, std::memory_order_release);
+    ++next;
+  }
+
+  /**
+   * @brief Dispatch the published records to a local actuator.
+   *
+   * @param target - Actuator, or any callable taking the action arguments.
+   * @param max - Maximum number of records to dispatch.
+   * @return The number of records dispatched.
+   */
+  template<typename targetT>
+  std::size_t poll(targetT& target, std::size_t max = std::numeric_limits<std::size_t>::max())
+  {
+    assert(header != nullptr);
+    std::size_t dispatched = 0;
+    char buffer[argumentsT::size + 1];
+    while (dispatched < max)
+    {
+      const auto published = header->head.load(std::memory_order_acquire);
+      if (next > published)
+      {
+        break;
+      }
+      if (published - next > mask)
+      {
+        // overwritten by the publisher: resume from the oldest record
+        lostRecords += published - mask - next;
+        next = published - mask;
+      }
+      // a published record whose sequence changed is being overwritten by a newer one, by a publisher that may
+      // have died meanwhile: it is lost, rather than waited for
+      auto& r = record(next & mask);
+      bool intact = r.sequence.load(std::memory_order_acquire) == next;
+      if (intact)
+      {
+        std::memcpy(buffer, &r + 1, argumentsT::size);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        intact = r.sequence.load(std::memory_order_relaxed) == next;
+      }
+      ++next;
+      if (!intact)
+      {
+        ++lostRecords;
+        continue;
+      }
+      std::apply(target, argumentsT::read(buffer));
+      ++dispatched;
+    }
+    return dispatched;
+  }
+
+  /**
+   * @brief Number of records a subscriber missed, because the publisher overwrote them before they were polled.
+   *
+   */
+  std::uint64_t lost() const { return lostRecords; }
+
+  private:
+  detail::ring_header* header = nullptr; //!< Mapped shared memory.
+  std::size_t size = 0; //!< Mapped size.
+  std::size_t mask = 0; //!< Capacity - 1.
+  std::uint64_t next = 1; //!< Sequence number of the next record to publish, or to poll.
+  std::uint64_t lostRecords = 0;
+
+  bool map(int fd, std::size_t bytes)
+  {
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+      return false;
+    }
+    header = static_cast<detail::ring_header*>(mapping);
+    size = bytes;
+    return true;
+  }
+
+  detail::ring_record& record(std::size_t index) const
+  {
+    return *reinterpret_cast<detail::ring_record*>(reinterpret_cast<char*>(header) +
+                                                   detail::ring_record_offset<argumentsT>(index));
+  }
+
+  template<typename ...Args>
+  static void write(char* out, const Args&... args)
+  {
+    // converted to the action argument types, as they are read back
+    write_as(out, static_cast<const argumentsT*>(nullptr), args...);
+  }
+
+  template<typename ...Ts, typename ...Args>
+  static void write_as(char* out, const detail::packed_arguments<Ts...>*, const Args&... args)
+  {
+    static_assert(sizeof...(Ts) == sizeof...(Args), "the emission arguments must match the action arity");
+    detail::packed_arguments<Ts...>::write(out, static_cast<Ts>(args)...);
+  }
+};
+
+}
@@ -0,0 +1,158 @@
+/**
+ * @brief Memoization of the results of \ref untangle::actuator emissions.
+ *
+ * @file actuator_memo.hpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark For actuators whose actions are pure functions of their arguments, a \ref untangle::memoized actuator
+ * keeps the results of the recent emissions, keyed by their arguments, and returns them without invoking the
+ * actions again. The cache is bounded, evicting the least recently used results.
+ */
+#pragma once
+
+#include "actuator.hpp"
+
+#include <cassert>
+#include <list>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace untangle
+{
+/**
+ * @brief An actuator whose results are cached, keyed by the emission arguments.
+ *
+ * The cache is cleared when the actions of the actuator change (see actuator::revision()), and when a miss drops
+ * invalid actions, such as bindings to destroyed objects. Until then, a hit returns the results cached with those
+ * of the invalid actions. When the objects the actions read change, the cache must be invalidated explicitly.
+ *
+ * It refers to an actuator, that must outlive it.
+ *
+ * @tparam actuatorT Type of the actuator. Its actions must have a non-void result type, and their argument types
+ * must be copyable and ordered by operator<.
+ */
+template<typename actuatorT>
+struct memoized
+{
+  using actionT = decltype(std::declval<actuatorT&>().type());
+  using argumentsT = typename action_arguments<actionT>::type;
+  using resultsT = typename actuatorT::resultsT;
+
+  static_assert(!std::is_void_v<typename actionT::result_type>, "only the results of non-void actions can be cached");
+
+  /**
+   * @brief Construct a memoized actuator.
+   *
+   * @param actuator - Actuator emitted on a cache miss.
+   * @param capacity - Maximum number of cached emissions.
+   */
+  explicit memoized(actuatorT& actuator, std::size_t capacity = 64) : actuator(actuator), capacity(capacity)
+  {
+    assert(capacity > 0);
+  }
+
+  memoized(const memoized&) = delete;
+  memoized& operator=(const memoized&) = delete;
+
+  /**
+   * @brief Return the cached results of an emission, or emit and cache them.
+   *
+   * @param args - Arguments list must match the action arity.
+   * @return The results, valid until the next call or invalidation.
+   */
+  template<typename ...Args>
+  const resultsT& operator()(Args&&... args)
+  {
+    if (actuator.revision() != revision)
+    {
+      invalidate();
+      revision = actuator.revision();
+    }
+    argumentsT key(args...);
+    const auto it = index.find(key);
+    if (it != index.end())
+    {
+      ++hitCount;
+      entries.splice(entries.begin(), entries, it->second);
+      return it->second->second;
+    }
+    ++missCount;
+    const auto actionCount = actuator.actions().size();
+    actuator(std::forward<Args>(args)...);
+    // an action changed the actions while invoked: the results are not cached
+    if (actuator.revision() != revision)
+    {
+      invalidate();
+      revision = actuator.revision();
+      return actuator.results;
+    }
+    // the invalid actions dropped by the emission, without changing the revision, left no result: the results
+    // cached before still hold theirs, and are discarded, while these ones are cached
+    if (actuator.actions().size() != actionCount)
+    {
+      invalidate();
+    }
+    if (entries.size() == capacity)
+    {
+      index.erase(entries.back().first);
+      entries.pop_back();
+    }
+    entries.emplace_front(std::move(key), actuator.results);
+    index.emplace(entries.front().first, entries.begin());
+    return entries.front().second;
+  }
+
+  /**
+   * @brief Discard all the cached results.
+   *
+   */
+  void invalidate()
+  {
+    index.clear();
+    entries.clear();
+  }
+
+  /**
+   * @brief Discard the cached results of one emission.
+   *
+   * @return true - if they were cached.
+   */
+  template<typename ...Args>
+  bool invalidate(const Args&... args)
+  {
+    const auto it = index.find(argumentsT(args...));
+    if (it == index.end())
+    {
+      return false;
+    }
+    entries.erase(it->second);
+    index.erase(it);
+    return true;
+  }
+
+  /**
+   * @brief Number of cached emissions.
+   *
+   */
+  std::size_t size() const { return entries.size(); }
+
+  std::size_t hits() const { return hitCount; }
+
+  std::size_t misses() const { return missCount; }
+
+  private:
+  using entriesT = std::list<std::pair<argumentsT, resultsT>>; //!< Cached emissions, most recently used first.
+
+  actuatorT& actuator;
+  const std::size_t capacity;
+  entriesT entries;
+  std::map<argumentsT, typename entriesT::iterator> index; //!< Cached emissions by arguments.
+  std::uint64_t revision = 0; //!< Actuator revision of the cached results.
+  std::size_t hitCount = 0;
+  std::size_t missCount = 0;
+};
+
+}
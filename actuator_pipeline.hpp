@@ -0,0 +1,119 @@
+/**
+ * @brief Pipelines of \ref untangle::actuator stages.
+ *
+ * @file actuator_pipeline.hpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark A pipeline `a | b | c` invokes the actions of `a`, and passes each of their results to the actions of
+ * `b`, whose results go to the actions of `c`. Only the last stage collects its results. The stages are nested at
+ * compile time, through actuator::invokeEach(), so there is no intermediate results vector and no extra
+ * type-erased call between the stages.
+ */
+#pragma once
+
+#include "actuator.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace untangle
+{
+/**
+ * @brief A chain of actuators, each stage emitting the next one with its results.
+ *
+ * It refers to the stage actuators, that must outlive it.
+ *
+ * @tparam actuatorTs Stage actuator types. All of them but the last one must have a non-void result type.
+ */
+template<typename ...actuatorTs>
+struct pipeline
+{
+  static_assert(sizeof...(actuatorTs) >= 2, "a pipeline needs at least two stages");
+
+  using lastT = std::tuple_element_t<sizeof...(actuatorTs) - 1, std::tuple<actuatorTs...>>;
+
+  explicit pipeline(actuatorTs&... stages) : stages(stages...) {}
+
+  /**
+   * @brief Run the pipeline, collecting the results in the last stage actuator#results.
+   *
+   * @param args - Arguments of the first stage.
+   */
+  template<typename ...Args>
+  void operator()(Args&&... args)
+  {
+    auto& last = std::get<sizeof...(actuatorTs) - 1>(stages);
+    last.results.clear();
+    into([&last](auto&&... result)
+    {
+      if constexpr (sizeof...(result) > 0)
+      {
+        last.results.push_back(std::forward<decltype(result)>(result)...);
+      }
+    }, std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Run the pipeline, passing the results of the last stage to a sink.
+   *
+   * @param sink - Callable invoked with each result of the last stage; without arguments if it is void.
+   * @param args - Arguments of the first stage.
+   */
+  template<typename sinkT, typename ...Args>
+  void into(sinkT&& sink, Args&&... args)
+  {
+    run<0>(sink, args...);
+  }
+
+  /**
+   * @brief Append a stage.
+   *
+   */
+  template<typename actionT, typename allocatorT>
+  pipeline<actuatorTs..., actuator<actionT, allocatorT>> operator|(actuator<actionT, allocatorT>& next) const
+  {
+    return std::apply([&next](auto&... current)
+    {
+      return pipeline<actuatorTs..., actuator<actionT, allocatorT>>(current..., next);
+    }, stages);
+  }
+
+  private:
+  std::tuple<actuatorTs&...> stages;
+
+  template<std::size_t I, typename sinkT, typename ...Args>
+  void run(sinkT& sink, Args&... args)
+  {
+    auto& stage = std::get<I>(stages);
+    if constexpr (I + 1 == sizeof...(actuatorTs))
+    {
+      stage.invokeEach(sink, args...);
+    }
+    else
+    {
+      using stageT = std::tuple_element_t<I, std::tuple<actuatorTs...>>;
+      static_assert(!std::is_void_v<typename decltype(std::declval<stageT&>().type())::result_type>,
+                    "only the last stage of a pipeline may have a void result type");
+      stage.invokeEach([this, &sink](auto&& result)
+      {
+        run<I + 1>(sink, result);
+      }, args...);
+    }
+  }
+};
+
+/**
+ * @brief Chain two actuators into a pipeline.
+ *
+ * @ingroup untangle_functions
+ */
+template<typename actionT1, typename allocatorT1, typename actionT2, typename allocatorT2>
+pipeline<actuator<actionT1, allocatorT1>, actuator<actionT2, allocatorT2>>
+operator|(actuator<actionT1, allocatorT1>& first, actuator<actionT2, allocatorT2>& second)
+{
+  return pipeline<actuator<actionT1, allocatorT1>, actuator<actionT2, allocatorT2>>(first, second);
+}
+
+}
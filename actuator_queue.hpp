@@ -0,0 +1,245 @@
+/**
+ * @brief Bounded queue of \ref untangle::actuator emissions, shedding the least important ones under overload.
+ *
+ * @file actuator_queue.hpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark Producers push emissions with a priority into a \ref untangle::queued actuator, from any thread, and a
+ * consumer drains them. The queue holds at most its capacity: when it is full, an emission of a lower priority is
+ * shed to make room, or the incoming one is dropped or coalesced, following an \ref untangle::overload_policy.
+ * The emissions are drained by priority, then in the order they were pushed, so the latency of the critical
+ * emissions does not depend on the backlog of the others.
+ */
+#pragma once
+
+#include "actuator.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace untangle
+{
+/**
+ * @brief Priority of a queued emission.
+ *
+ */
+enum class emission_priority : std::uint8_t
+{
+  low, //!< First shed under overload.
+  normal,
+  high,
+  critical //!< Never shed for another priority.
+};
+
+/**
+ * @brief What a full queue does with an incoming emission.
+ *
+ */
+enum class overload_policy
+{
+  drop_newest, //!< Drop the incoming emission, whatever the priorities.
+  shed_lowest, //!< Drop the oldest emission of the lowest priority below the incoming one, otherwise drop the incoming one.
+  coalesce //!< As shed_lowest, but replace the newest emission of the same priority instead of dropping the incoming one.
+};
+
+/**
+ * @brief An actuator whose emissions are queued, with a bounded capacity, and emitted by \ref drain().
+ *
+ * It refers to an actuator, that must outlive it. \ref push() may be called from any thread, \ref drain() from
+ * one thread at a time: the actions are invoked on the thread draining the queue, without holding its lock.
+ *
+ * @tparam actuatorT Type of the actuator. The argument types of its actions must be copyable.
+ */
+template<typename actuatorT>
+struct queued
+{
+  using actionT = decltype(std::declval<actuatorT&>().type());
+  using argumentsT = typename action_arguments<actionT>::type;
+
+  static constexpr std::size_t priorityCount = static_cast<std::size_t>(emission_priority::critical) + 1;
+
+  /**
+   * @brief Construct a queued actuator.
+   *
+   * @param actuator - Actuator emitted when the queue is drained.
+   * @param capacity - Maximum number of queued emissions.
+   * @param policy - Overload policy, applied when the queue is full.
+   */
+  explicit queued(actuatorT& actuator, std::size_t capacity = 1024, overload_policy policy = overload_policy::shed_lowest)
+  : actuator(actuator)
+  , capacity(capacity)
+  , policy(policy)
+  {
+    assert(capacity > 0);
+  }
+
+  queued(const queued&) = delete;
+  queued& operator=(const queued&) = delete;
+
+  /**
+   * @brief Queue an emission.
+   *
+   * @param priority - Priority of the emission.
+   * @param args - Arguments list must match the action arity. They are copied into the queue.
+   * @return true - if the emission is queued, possibly coalesced with a queued one.
+   * @return false - if it is dropped.
+   */
+  template<typename ...Args>
+  bool push(emission_priority priority, Args&&... args)
+  {
+    const auto p = static_cast<std::size_t>(priority);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queuedCount == capacity)
+    {
+      const auto lowest = lowestQueued();
+      if (policy != overload_policy::drop_newest && lowest < p)
+      {
+        // make room by shedding the oldest emission of the lowest priority
+        queues[lowest].pop_front();
+        --queuedCount;
+        ++droppedCount[lowest];
+      }
+      else if (policy == overload_policy::coalesce && lowest == p)
+      {
+        queues[p].back() = argumentsT(std::forward<Args>(args)...);
+        ++coalescedCount[p];
+        return true;
+      }
+      else
+      {
+        ++droppedCount[p];
+        return false;
+      }
+    }
+    queues[p].emplace_back(std::forward<Args>(args)...);
+    ++queuedCount;
+    return true;
+  }
+
+  /**
+   * @brief Emit the queued emissions, by priority, then in the order they were pushed.
+   *
+   * The emissions pushed meanwhile, including by the actions, are emitted too if they come before the maximum.
+   *
+   * @param max - Maximum number of emissions.
+   * @return The number of emissions.
+   */
+  std::size_t drain(std::size_t max = std::numeric_limits<std::size_t>::max())
+  {
+    std::size_t emitted = 0;
+    while (emitted < max)
+    {
+      auto arguments = pop();
+      if (!arguments)
+      {
+        break;
+      }
+      // as lvalues: every action of the actuator receives the same arguments
+      std::apply(actuator, *arguments);
+      ++emitted;
+    }
+    return emitted;
+  }
+
+  /**
+   * @brief Number of queued emissions.
+   *
+   */
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queuedCount;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Number of emissions of a priority dropped, the incoming ones and the shed ones.
+   *
+   */
+  std::uint64_t dropped(emission_priority priority) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return droppedCount[static_cast<std::size_t>(priority)];
+  }
+
+  /**
+   * @brief Number of emissions of all the priorities dropped.
+   *
+   */
+  std::uint64_t dropped() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::uint64_t total = 0;
+    for (const auto count : droppedCount)
+    {
+      total += count;
+    }
+    return total;
+  }
+
+  /**
+   * @brief Number of emissions of a priority whose arguments replaced those of a queued emission.
+   *
+   */
+  std::uint64_t coalesced(emission_priority priority) const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return coalescedCount[static_cast<std::size_t>(priority)];
+  }
+
+  private:
+  actuatorT& actuator;
+  const std::size_t capacity;
+  const overload_policy policy;
+  mutable std::mutex mutex; //!< Guards the queues and the counters.
+  std::array<std::deque<argumentsT>, priorityCount> queues; //!< Queued emissions, oldest first, by priority.
+  std::size_t queuedCount = 0;
+  std::array<std::uint64_t, priorityCount> droppedCount{};
+  std::array<std::uint64_t, priorityCount> coalescedCount{};
+
+  /**
+   * @brief The lowest priority of the queued emissions; the queue is not empty.
+   *
+   */
+  std::size_t lowestQueued() const
+  {
+    std::size_t p = 0;
+    while (queues[p].empty())
+    {
+      ++p;
+    }
+    return p;
+  }
+
+  /**
+   * @brief Take the next emission to drain, if any.
+   *
+   */
+  std::optional<argumentsT> pop()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::size_t p = priorityCount; p-- > 0;)
+    {
+      if (!queues[p].empty())
+      {
+        std::optional<argumentsT> arguments(std::move(queues[p].front()));
+        queues[p].pop_front();
+        --queuedCount;
+        return arguments;
+      }
+    }
+    return std::nullopt;
+  }
+};
+
+}
@@ -0,0 +1,651 @@
+/**
+ * @brief Record and replay of \ref untangle::actuator emissions.
+ *
+ * @file actuator_record.hpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark Emissions are appended to a memory-mapped log file by a \ref untangle::recorder, through a
+ * \ref untangle::recorded actuator. A \ref untangle::replay_log re-emits them, at full speed or with the original
+ * pacing, against another actuator of the same action type.
+ * The arguments are serialized by \ref untangle::serializer, that handles trivially copyable types and
+ * std::string, and can be specialized for other types. The log records the signature of the argument types, and
+ * a log is only replayed against an actuator with the same one. The types other than the arithmetic ones and
+ * std::string are identified in the signature by the tag of their serializer, if it has one, or else by their name
+ * as given by the compiler: give them a tag for their logs to be replayed by builds of other compilers.
+ * This header is POSIX-only: mapping files relies on open and mmap.
+ */
+#pragma once
+
+#include "actuator.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace untangle
+{
+/**
+ * @brief Serialization of an emission argument.
+ *
+ * The primary template handles trivially copyable types by copying their bytes. Pointers are rejected: the
+ * addresses they hold are meaningless when the log is replayed.
+ * Specialize it to record other types:
+ * @code
+ * template<> struct serializer<my_type>
+ * {
+ *   // optional: identifies the type in the log signature, instead of its name as given by the compiler
+ *   static constexpr std::uint64_t tag = 0x6d795f74797065;
+ *   static void write(std::string& out, const my_type& value);
+ *   // advances in past the value, or returns std::nullopt if the value does not fit before end
+ *   static std::optional<my_type> read(const char*& in, const char* end);
+ * };
+ * @endcode
+ */
+template<typename T, typename = void>
+struct serializer
+{
+  static_assert(std::is_trivially_copyable_v<T>, "untangle::serializer must be specialized for this type");
+  static_assert(!std::is_pointer_v<T>, "untangle::serializer cannot record pointers");
+
+  static void write(std::string& out, const T& value)
+  {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  static std::optional<T> read(const char*& in, const char* end)
+  {
+    if (static_cast<std::size_t>(end - in) < sizeof(T))
+    {
+      return std::nullopt;
+    }
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+    return value;
+  }
+};
+
+/**
+ * @brief Serialization of std::string arguments: length followed by characters.
+ *
+ */
+template<>
+struct serializer<std::string>
+{
+  static void write(std::string& out, const std::string& value)
+  {
+    serializer<std::uint64_t>::write(out, value.size());
+    out.append(value);
+  }
+
+  static std::optional<std::string> read(const char*& in, const char* end)
+  {
+    const auto size = serializer<std::uint64_t>::read(in, end);
+    if (!size || *size > static_cast<std::uint64_t>(end - in))
+    {
+      return std::nullopt;
+    }
+    std::string value(in, static_cast<std::size_t>(*size));
+    in += *size;
+    return value;
+  }
+};
+
+/**
+ * @brief Log record kinds.
+ *
+ */
+enum class record_kind : std::uint8_t
+{
+  call, //!< actuator::operator()
+  invoke_action //!< actuator::invokeAction()
+};
+
+namespace detail
+{
+/**
+ * @brief Log file header.
+ *
+ */
+struct log_header
+{
+  static constexpr char magicValue[8] = {'U', 'N', 'T', 'G', 'L', 'O', 'G', '2'};
+
+  char magic[8]; //!< File type marker.
+  std::uint64_t size; //!< Bytes used by the records.
+  std::uint64_t signature; //!< Signature of the argument types, 0 until the first record.
+};
+
+/**
+ * @brief Log record header, followed by the action name and the serialized arguments.
+ *
+ * @remark Records are aligned to 8 bytes.
+ */
+struct record_header
+{
+  std::uint64_t timestamp; //!< Nanoseconds since the recording started.
+  std::uint32_t size; //!< Record size, including this header and the padding.
+  std::uint16_t nameSize; //!< Length of the action name, for record_kind::invoke_action.
+  record_kind kind; //!< Recorded call.
+};
+
+constexpr std::size_t align(std::size_t size)
+{
+  return (size + 7) & ~std::size_t(7);
+}
+
+constexpr std::uint64_t fnvBasis = 14695981039346656037ull; //!< FNV-1a offset basis.
+
+/**
+ * @brief One FNV-1a step, mixing a value in a hash.
+ *
+ */
+constexpr std::uint64_t fnv_mix(std::uint64_t hash, std::uint64_t value)
+{
+  return (hash ^ value) * 1099511628211ull;
+}
+
+/**
+ * @brief FNV-1a hash of a string, continuing a hash.
+ *
+ */
+constexpr std::uint64_t fnv_hash(std::string_view text, std::uint64_t hash)
+{
+  for (const auto c : text)
+  {
+    hash = fnv_mix(hash, static_cast<unsigned char>(c));
+  }
+  return hash;
+}
+
+/**
+ * @brief The name of a type, within the signature of this function as given by the compiler.
+ *
+ */
+template<typename T>
+constexpr std::string_view type_name()
+{
+#if defined(_MSC_VER)
+  return __FUNCSIG__;
+#else
+  return __PRETTY_FUNCTION__;
+#endif
+}
+
+template<typename T, typename = void>
+struct has_serializer_tag : std::false_type
+{
+};
+
+template<typename T>
+struct has_serializer_tag<T, std::void_t<decltype(serializer<T>::tag)>> : std::true_type
+{
+};
+
+/**
+ * @brief Code of an argument type in a log signature: its size, and what kind of type it is.
+ *
+ * The other types, such as enums and structures, are told apart by the tag of their \ref serializer, or else by
+ * their name: two of them with the same size do not have the same code.
+ */
+template<typename T>
+constexpr std::uint64_t argument_code()
+{
+  const std::uint64_t kind = std::is_same_v<T, std::string> ? 1
+                           : std::is_floating_point_v<T> ? 2
+                           : std::is_integral_v<T> && std::is_signed_v<T> ? 3
+                           : std::is_integral_v<T> ? 4
+                           : 5;
+  const std::uint64_t code = static_cast<std::uint64_t>(sizeof(T)) << 8 | kind;
+  if constexpr (has_serializer_tag<T>::value)
+  {
+    return fnv_mix(fnv_mix(fnvBasis, code), static_cast<std::uint64_t>(serializer<T>::tag));
+  }
+  else if (kind == 5)
+  {
+    return fnv_hash(type_name<T>(), fnv_mix(fnvBasis, code));
+  }
+  return code;
+}
+
+/**
+ * @brief Signature of a list of argument types (FNV-1a over their codes), never 0.
+ *
+ */
+template<typename ...Args>
+constexpr std::uint64_t argument_signature()
+{
+  std::uint64_t hash = fnvBasis;
+  for (const auto code : {static_cast<std::uint64_t>(sizeof...(Args)), argument_code<Args>()...})
+  {
+    hash = fnv_mix(hash, code);
+  }
+  return hash ? hash : 1;
+}
+
+template<typename tupleT>
+struct tuple_signature;
+
+template<typename ...Args>
+struct tuple_signature<std::tuple<Args...>>
+{
+  static constexpr std::uint64_t value = argument_signature<Args...>();
+};
+} // namespace detail
+
+/**
+ * @brief Append-only log of emissions, in a memory-mapped file.
+ *
+ * @remark The file grows by doubling its mapping. On close, it is truncated to the recorded size.
+ * A recorder must be used from one thread at a time.
+ */
+struct recorder
+{
+  recorder() = default;
+  recorder(const recorder&) = delete;
+  recorder& operator=(const recorder&) = delete;
+  ~recorder()
+  {
+    close();
+  }
+
+  /**
+   * @brief Create, or truncate, a log file and map it.
+   *
+   * @param path - Log file path.
+   * @param capacity - Initial mapping size, in bytes.
+   * @return true - if the log is open for recording.
+   * @return false - if the file could not be created or mapped.
+   */
+  bool open(const std::string& path, std::size_t capacity = 1 << 20)
+  {
+    close();
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+      return false;
+    }
+    if (!map(detail::align(std::max(capacity, sizeof(detail::log_header) + sizeof(detail::record_header)))))
+    {
+      close();
+      return false;
+    }
+    auto* header = reinterpret_cast<detail::log_header*>(data);
+    std::memcpy(header->magic, detail::log_header::magicValue, sizeof(header->magic));
+    header->size = 0;
+    header->signature = 0;
+    used = sizeof(detail::log_header);
+    start = std::chrono::steady_clock::now();
+    return true;
+  }
+
+  /**
+   * @brief Unmap the log and truncate the file to the recorded size.
+   *
+   */
+  void close()
+  {
+    if (data)
+    {
+      ::munmap(data, capacity);
+      data = nullptr;
+    }
+    if (fd >= 0)
+    {
+      [[maybe_unused]] const auto truncated = ::ftruncate(fd, static_cast<off_t>(used));
+      ::close(fd);
+      fd = -1;
+    }
+    capacity = 0;
+    used = 0;
+  }
+
+  bool is_open() const { return data != nullptr; }
+
+  /**
+   * @brief Number of bytes recorded, including the file header.
+   *
+   */
+  std::size_t size() const { return used; }
+
+  /**
+   * @brief Append an emission record.
+   *
+   * @param kind - Recorded call.
+   * @param name - Action name, for record_kind::invoke_action.
+   * @param args - Arguments, serialized by \ref serializer. Their types must be the same for all the records.
+   * @return true - if the record was appended.
+   * @return false - if the log is not open or could not grow, if the argument types differ from those of the
+   * previous records, or if the name or the record is too long for the record header.
+   */
+  template<typename ...Args>
+  bool record(record_kind kind, const std::string& name, const Args&... args)
+  {
+    constexpr auto signature = detail::argument_signature<Args...>();
+    if (!data || name.size() > std::numeric_limits<std::uint16_t>::max())
+    {
+      return false;
+    }
+    auto* logHeader = reinterpret_cast<detail::log_header*>(data);
+    if (logHeader->signature != 0 && logHeader->signature != signature)
+    {
+      return false;
+    }
+    const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start).count();
+    scratch.clear();
+    (serializer<Args>::write(scratch, args), ...);
+
+    const auto size = detail::align(sizeof(detail::record_header) + name.size() + scratch.size());
+    if (size > std::numeric_limits<std::uint32_t>::max() || (used + size > capacity && !grow(used + size)))
+    {
+      return false;
+    }
+    auto* out = data + used;
+    const detail::record_header header{static_cast<std::uint64_t>(timestamp), static_cast<std::uint32_t>(size),
+                                       static_cast<std::uint16_t>(name.size()), kind};
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), name.data(), name.size());
+    std::memcpy(out + sizeof(header) + name.size(), scratch.data(), scratch.size());
+    used += size;
+    logHeader = reinterpret_cast<detail::log_header*>(data);
+    logHeader->size = used - sizeof(detail::log_header);
+    logHeader->signature = signature;
+    return true;
+  }
+
+  private:
+  int fd = -1;
+  char* data = nullptr; //!< Mapped file.
+  std::size_t capacity = 0; //!< Mapped size.
+  std::size_t used = 0; //!< Bytes written, including the file header.
+  std::string scratch; //!< Serialized arguments of the current record.
+  std::chrono::steady_clock::time_point start;
+
+  bool map(std::size_t size)
+  {
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+      return false;
+    }
+    void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+      return false;
+    }
+    data = static_cast<char*>(mapping);
+    capacity = size;
+    return true;
+  }
+
+  bool grow(std::size_t required)
+  {
+    auto size = capacity;
+    while (size < required)
+    {
+      size *= 2;
+    }
+    ::munmap(data, capacity);
+    data = nullptr;
+    return map(size);
+  }
+};
+
+/**
+ * @brief An actuator whose emissions are recorded before being dispatched.
+ *
+ * It refers to an actuator and a recorder, both must outlive it.
+ *
+ * @tparam actuatorT Type of the recorded actuator.
+ */
+template<typename actuatorT>
+struct recorded
+{
+  using argumentsT = typename action_arguments<decltype(std::declval<actuatorT&>().type())>::type;
+
+  recorded(actuatorT& actuator, recorder& log) : actuator(actuator), log(log) {}
+
+  /**
+   * @brief Record the call, then invoke the actuator.
+   *
+   */
+  template<typename ...Args>
+  void operator()(Args&&... args)
+  {
+    record(record_kind::call, std::string(), std::make_index_sequence<sizeof...(Args)>(), args...);
+    actuator(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Record the call, then invoke the named action of the actuator.
+   *
+   */
+  template<typename ...Args>
+  void invokeAction(std::string name, Args&&... args)
+  {
+    record(record_kind::invoke_action, name, std::make_index_sequence<sizeof...(Args)>(), args...);
+    actuator.invokeAction(std::move(name), std::forward<Args>(args)...);
+  }
+
+  private:
+  actuatorT& actuator;
+  recorder& log;
+
+  // arguments are recorded as the action argument types, so that they can be read back on replay
+  template<std::size_t ...I, typename ...Args>
+  void record(record_kind kind, const std::string& name, std::index_sequence<I...>, const Args&... args)
+  {
+    log.record(kind, name, static_cast<const std::tuple_element_t<I, argumentsT>&>(args)...);
+  }
+};
+
+/**
+ * @brief Replay pacing.
+ *
+ */
+enum class pacing
+{
+  full_speed, //!< Emit the records back to back.
+  original //!< Emit each record at its recorded time offset.
+};
+
+/**
+ * @brief Read-only view of a log written by a \ref recorder.
+ *
+ */
+struct replay_log
+{
+  replay_log() = default;
+  replay_log(const replay_log&) = delete;
+  replay_log& operator=(const replay_log&) = delete;
+  ~replay_log()
+  {
+    close();
+  }
+
+  /**
+   * @brief Map a log file.
+   *
+   * @param path - Log file path.
+   * @return true - if the file is a valid log.
+   * @return false - if the file could not be mapped, or it is not a log.
+   */
+  bool open(const std::string& path)
+  {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(detail::log_header))
+    {
+      void* mapping = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping != MAP_FAILED)
+      {
+        data = static_cast<const char*>(mapping);
+        capacity = static_cast<std::size_t>(st.st_size);
+      }
+    }
+    ::close(fd);
+    if (!data)
+    {
+      return false;
+    }
+    const auto* header = reinterpret_cast<const detail::log_header*>(data);
+    if (std::memcmp(header->magic, detail::log_header::magicValue, sizeof(header->magic)) != 0 ||
+        header->size > capacity - sizeof(detail::log_header))
+    {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  void close()
+  {
+    if (data)
+    {
+      ::munmap(const_cast<char*>(data), capacity);
+      data = nullptr;
+    }
+    capacity = 0;
+  }
+
+  /**
+   * @brief Number of records in the log.
+   *
+   */
+  std::size_t size() const
+  {
+    std::size_t count = 0;
+    for_each_record([&count](const detail::record_header&, const char*) { ++count; return true; });
+    return count;
+  }
+
+  /**
+   * @brief Check if the log can be replayed against an actuator: if it has the recorded argument types.
+   *
+   */
+  template<typename actuatorT>
+  bool compatible(actuatorT& actuator) const
+  {
+    using argumentsT = typename action_arguments<decltype(actuator.type())>::type;
+    if (!data)
+    {
+      return false;
+    }
+    const auto signature = reinterpret_cast<const detail::log_header*>(data)->signature;
+    return signature == 0 || signature == detail::tuple_signature<argumentsT>::value;
+  }
+
+  /**
+   * @brief Re-emit all the records against an actuator.
+   *
+   * The replay stops at the first record that is malformed: whose name or arguments do not fit in it.
+   *
+   * @param actuator - Actuator with the same action type as the recorded one.
+   * @param mode - Replay pacing.
+   * @return The number of records replayed, 0 if the log is not \ref compatible() with the actuator.
+   */
+  template<typename actuatorT>
+  std::size_t replay(actuatorT& actuator, pacing mode = pacing::full_speed) const
+  {
+    using argumentsT = typename action_arguments<decltype(actuator.type())>::type;
+    if (!compatible(actuator))
+    {
+      return 0;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t count = 0;
+    for_each_record([&](const detail::record_header& header, const char* record)
+    {
+      if (sizeof(header) + header.nameSize > header.size)
+      {
+        return false;
+      }
+      const char* in = record + sizeof(header) + header.nameSize;
+      auto args = read<argumentsT>(in, record + header.size, std::make_index_sequence<std::tuple_size_v<argumentsT>>());
+      if (!args)
+      {
+        return false;
+      }
+      if (mode == pacing::original)
+      {
+        std::this_thread::sleep_until(start + std::chrono::nanoseconds(header.timestamp));
+      }
+      if (header.kind == record_kind::invoke_action)
+      {
+        std::string name(record + sizeof(header), header.nameSize);
+        std::apply([&](auto&... a) { actuator.invokeAction(std::move(name), a...); }, *args);
+      }
+      else
+      {
+        std::apply([&](auto&... a) { actuator(a...); }, *args);
+      }
+      ++count;
+      return true;
+    });
+    return count;
+  }
+
+  private:
+  const char* data = nullptr; //!< Mapped file.
+  std::size_t capacity = 0; //!< Mapped size.
+
+  // function returns false to stop
+  template<typename functionT>
+  void for_each_record(functionT&& function) const
+  {
+    if (!data)
+    {
+      return;
+    }
+    const auto* header = reinterpret_cast<const detail::log_header*>(data);
+    const char* record = data + sizeof(detail::log_header);
+    const char* end = record + header->size;
+    while (record + sizeof(detail::record_header) <= end)
+    {
+      detail::record_header recordHeader;
+      std::memcpy(&recordHeader, record, sizeof(recordHeader));
+      if (recordHeader.size < sizeof(recordHeader) || record + recordHeader.size > end)
+      {
+        return;
+      }
+      if (!function(recordHeader, record))
+      {
+        return;
+      }
+      record += recordHeader.size;
+    }
+  }
+
+  // braced initialization guarantees the arguments are read in order
+  template<typename tupleT, std::size_t ...I>
+  static std::optional<tupleT> read(const char*& in, const char* end, std::index_sequence<I...>)
+  {
+    std::tuple<std::optional<std::tuple_element_t<I, tupleT>>...> values{
+      serializer<std::tuple_element_t<I, tupleT>>::read(in, end)...};
+    if (!(std::get<I>(values) && ...))
+    {
+      return std::nullopt;
+    }
+    return tupleT(std::move(*std::get<I>(values))...);
+  }
+};
+
+}
@@ -0,0 +1,372 @@
+/**
+ * @brief Timer wheel scheduling delayed and periodic \ref untangle::actuator emissions.
+ *
+ * @file actuator_timer.hpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark A hierarchical timer wheel of 4 levels of 256 slots: scheduling and cancelling a timer are O(1),
+ * and expired timers are processed in batches by \ref untangle::timer_wheel::advance(), on the thread calling it.
+ * Timers of the upper levels are moved down one level each time the level below completes a turn.
+ */
+#pragma once
+
+#include "actuator.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace untangle
+{
+/**
+ * @brief Scheduler of delayed and periodic callbacks, with a fixed tick resolution.
+ *
+ * @remark It is not thread-safe: schedule, cancel and advance from the same thread.
+ * Callbacks may schedule and cancel timers. Timers expiring on the same tick fire in no particular order.
+ */
+struct timer_wheel
+{
+  using clock = std::chrono::steady_clock;
+  using timer_id = std::uint64_t; //!< Timer handle: slot index and generation. 0 is never a valid timer.
+
+  /**
+   * @brief Construct a timer wheel.
+   *
+   * @param tick - Resolution of the timers. Delays are rounded up to a whole number of ticks.
+   * @param start - Time of tick 0.
+   */
+  explicit timer_wheel(clock::duration tick = std::chrono::milliseconds(1), clock::time_point start = clock::now())
+  : tick(tick)
+  , start(start)
+  {
+    for (auto& level : slots)
+    {
+      level.fill(none);
+    }
+  }
+
+  /**
+   * @brief Schedule a callback once, after a delay.
+   *
+   * @return The timer handle, to cancel it.
+   */
+  timer_id schedule(clock::duration delay, std::function<void()> callback)
+  {
+    return add(ticks(delay), 0, std::move(callback));
+  }
+
+  /**
+   * @brief Schedule a callback periodically, the first time after one period.
+   *
+   * @return The timer handle, to cancel it.
+   */
+  timer_id schedule_every(clock::duration period, std::function<void()> callback)
+  {
+    const auto periodTicks = std::max<std::uint64_t>(ticks(period), 1);
+    return add(periodTicks, periodTicks, std::move(callback));
+  }
+
+  /**
+   * @brief Schedule a call of an actuator, after a delay.
+   *
+   * The arguments are copied into the timer. The actuator must outlive the timer.
+   */
+  template<typename actuatorT, typename ...Args>
+  timer_id emit_after(clock::duration delay, actuatorT& actuator, Args... args)
+  {
+    return schedule(delay, [&actuator, args...]() mutable { actuator(args...); });
+  }
+
+  /**
+   * @brief Schedule a call of an actuator, periodically.
+   *
+   */
+  template<typename actuatorT, typename ...Args>
+  timer_id emit_every(clock::duration period, actuatorT& actuator, Args... args)
+  {
+    return schedule_every(period, [&actuator, args...]() mutable { actuator(args...); });
+  }
+
+  /**
+   * @brief Schedule the invocation of a named action of an actuator, after a delay.
+   *
+   */
+  template<typename actuatorT, typename ...Args>
+  timer_id invoke_action_after(clock::duration delay, actuatorT& actuator, std::string name, Args... args)
+  {
+    return schedule(delay, [&actuator, name = std::move(name), args...]() mutable
+    {
+      actuator.invokeAction(name, args...);
+    });
+  }
+
+  /**
+   * @brief Cancel a timer.
+   *
+   * @return true - if the timer was pending.
+   * @return false - if the timer already expired, or was cancelled.
+   */
+  bool cancel(timer_id id)
+  {
+    const auto index = static_cast<std::uint32_t>(id);
+    if (index >= timers.size() || timers[index].generation != static_cast<std::uint32_t>(id >> 32) ||
+        !timers[index].callback)
+    {
+      return false;
+    }
+    auto& timer = timers[index];
+    if (timer.level != expiring)
+    {
+      unlink(index);
+    }
+    release(index);
+    return true;
+  }
+
+  /**
+   * @brief Fire all the timers expired at a given time.
+   *
+   * @param now - Current time.
+   * @return The number of callbacks invoked.
+   */
+  std::size_t advance(clock::time_point now = clock::now())
+  {
+    if (now < start)
+    {
+      return 0;
+    }
+    const auto target = static_cast<std::uint64_t>((now - start) / tick);
+    std::size_t fired = 0;
+    while (current < target)
+    {
+      if (pending == 0)
+      {
+        current = target;
+        break;
+      }
+      ++current;
+      if ((current & mask) == 0)
+      {
+        cascade();
+      }
+      fired += expire(slots[0][current & mask]);
+    }
+    return fired;
+  }
+
+  /**
+   * @brief Number of pending timers.
+   *
+   */
+  std::size_t size() const { return pending; }
+
+  /**
+   * @brief Current tick: the timers up to it have been fired.
+   *
+   */
+  std::uint64_t now() const { return current; }
+
+  private:
+  static constexpr std::size_t levels = 4;
+  static constexpr std::size_t bits = 8;
+  static constexpr std::uint64_t mask = (1u << bits) - 1;
+  static constexpr std::uint32_t none = 0xffffffff;
+  static constexpr std::uint8_t expiring = 0xff; //!< Level of the timers being fired.
+
+  struct timer
+  {
+    std::function<void()> callback; //!< Empty for a free timer.
+    std::uint64_t expiry = 0; //!< Tick of expiry.
+    std::uint64_t period = 0; //!< Period in ticks, 0 for a one-shot timer.
+    std::uint32_t previous = none;
+    std::uint32_t next = none;
+    std::uint32_t generation = 1;
+    std::uint8_t level = 0; //!< Wheel level, or expiring.
+    std::uint8_t slot = 0; //!< Slot in the level.
+  };
+
+  clock::duration tick;
+  clock::time_point start;
+  std::uint64_t current = 0;
+  std::size_t pending = 0;
+  std::vector<timer> timers; //!< Timer pool.
+  std::vector<std::uint32_t> freeTimers;
+  std::array<std::array<std::uint32_t, 1u << bits>, levels> slots{}; //!< First timer of each slot.
+  std::vector<std::uint32_t> expired; //!< Timers being fired.
+
+  std::uint64_t ticks(clock::duration delay) const
+  {
+    if (delay <= clock::duration::zero())
+    {
+      return 0;
+    }
+    return static_cast<std::uint64_t>((delay + tick - clock::duration(1)) / tick);
+  }
+
+  timer_id add(std::uint64_t delay, std::uint64_t period, std::function<void()> callback)
+  {
+    std::uint32_t index;
+    if (freeTimers.empty())
+    {
+      index = static_cast<std::uint32_t>(timers.size());
+      timers.emplace_back();
+    }
+    else
+    {
+      index = freeTimers.back();
+      freeTimers.pop_back();
+    }
+    auto& timer = timers[index];
+    timer.callback = std::move(callback);
+    // a timer due now fires on the next tick
+    timer.expiry = current + std::max<std::uint64_t>(delay, 1);
+    timer.period = period;
+    link(index);
+    ++pending;
+    return (static_cast<timer_id>(timer.generation) << 32) | index;
+  }
+
+  void release(std::uint32_t index)
+  {
+    auto& timer = timers[index];
+    timer.callback = nullptr;
+    ++timer.generation;
+    freeTimers.push_back(index);
+    --pending;
+  }
+
+  /**
+   * @brief Insert a timer in the slot of its expiry.
+   *
+   * The level is the lowest one whose range covers the delay to the expiry, so the slot is reached, or cascaded
+   * down, within one turn of that level. The delay, rather than the upper bits of the expiry, chooses the level:
+   * an expiry past a carry of the upper bits of the current tick stays in range.
+   */
+  void link(std::uint32_t index)
+  {
+    auto& timer = timers[index];
+    const auto delay = timer.expiry > current ? timer.expiry - current : 0;
+    std::size_t level = 0;
+    while (level < levels && (delay >> (bits * (level + 1))) != 0)
+    {
+      ++level;
+    }
+    std::size_t slot;
+    if (level == levels)
+    {
+      // beyond the wheel range: wait in the last slot of the top level to be cascaded, and placed, again
+      level = levels - 1;
+      slot = ((current >> (bits * level)) - 1) & mask;
+    }
+    else
+    {
+      slot = (timer.expiry >> (bits * level)) & mask;
+    }
+    auto& head = slots[level][slot];
+    timer.level = static_cast<std::uint8_t>(level);
+    timer.slot = static_cast<std::uint8_t>(slot);
+    timer.previous = none;
+    timer.next = head;
+    if (head != none)
+    {
+      timers[head].previous = index;
+    }
+    head = index;
+  }
+
+  void unlink(std::uint32_t index)
+  {
+    auto& timer = timers[index];
+    if (timer.previous != none)
+    {
+      timers[timer.previous].next = timer.next;
+    }
+    else
+    {
+      slots[timer.level][timer.slot] = timer.next;
+    }
+    if (timer.next != none)
+    {
+      timers[timer.next].previous = timer.previous;
+    }
+  }
+
+  /**
+   * @brief Move the timers of the upper levels down, when the levels below complete a turn.
+   *
+   */
+  void cascade()
+  {
+    for (std::size_t level = 1; level < levels; ++level)
+    {
+      auto& head = slots[level][(current >> (bits * level)) & mask];
+      auto index = head;
+      head = none;
+      while (index != none)
+      {
+        const auto next = timers[index].next;
+        link(index);
+        index = next;
+      }
+      if (((current >> (bits * level)) & mask) != 0)
+      {
+        break;
+      }
+    }
+  }
+
+  /**
+   * @brief Fire the timers of a slot of the first level.
+   *
+   * @return The number of callbacks invoked.
+   */
+  std::size_t expire(std::uint32_t& head)
+  {
+    expired.clear();
+    for (auto index = head; index != none; index = timers[index].next)
+    {
+      timers[index].level = expiring;
+      expired.push_back(index);
+    }
+    head = none;
+    std::size_t fired = 0;
+    // callbacks may schedule timers: the pool may grow, so timers are accessed by index
+    for (std::size_t i = 0; i < expired.size(); ++i)
+    {
+      const auto index = expired[i];
+      if (timers[index].level != expiring || !timers[index].callback)
+      {
+        continue; // cancelled by a previous callback
+      }
+      const auto generation = timers[index].generation;
+      auto callback = std::move(timers[index].callback);
+      timers[index].callback = [] {};
+      callback();
+      ++fired;
+      auto& timer = timers[index];
+      if (timer.generation != generation)
+      {
+        continue; // cancelled by its own callback
+      }
+      if (timer.period != 0)
+      {
+        timer.callback = std::move(callback);
+        timer.expiry = current + timer.period;
+        link(index);
+      }
+      else
+      {
+        release(index);
+      }
+    }
+    return fired;
+  }
+};
+
+}
@@ -0,0 +1,334 @@
+/**
+ * @brief Dispatch tracing of \ref untangle::actuator, exported in Chrome trace-event JSON format.
+ *
+ * @file actuator_trace.hpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark Tracing is compiled in only when UNTANGLE_TRACE is defined before including actuator.hpp.
+ * Each emission (call operator, invokeAction) and each action it invokes is recorded as a complete event,
+ * holding the actuator identity, the action identity, the nesting depth and the timestamps.
+ * Events are stored in a buffer owned by the recording thread, without locks, and can be written to a file by
+ * \ref untangle::trace::dump(), to be loaded in chrome://tracing or https://ui.perfetto.dev.
+ * The buffers of the finished threads are kept until their events are dumped or cleared, then freed.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifndef UNTANGLE_TRACE_CAPACITY
+#define UNTANGLE_TRACE_CAPACITY (1u << 16) //!< Events recorded per thread, the following ones are dropped.
+#endif
+
+#ifndef UNTANGLE_TRACE_THREADS
+#define UNTANGLE_TRACE_THREADS 64 //!< Thread buffers registered at once, the following threads are not traced.
+#endif
+
+namespace untangle::trace
+{
+/**
+ * @brief A traced emission, or an action invoked by an emission.
+ *
+ */
+struct event
+{
+  static constexpr std::size_t nameSize = 24;
+
+  const void* actuator; //!< Identity of the actuator.
+  const void* action; //!< Identity of the action, null for the emission itself.
+  std::uint64_t begin; //!< Start time, in nanoseconds.
+  std::uint64_t end; //!< End time, in nanoseconds.
+  std::uint32_t depth; //!< Nesting depth: actions emitting other actuators are one level deeper.
+  char name[nameSize]; //!< Emission name, truncated.
+};
+
+/**
+ * @brief Events recorded by one thread.
+ *
+ * @remark Only the owning thread writes events; the number of events is published with release semantics,
+ * so a dump from another thread reads only complete events.
+ */
+struct thread_buffer
+{
+  thread_buffer(std::uint32_t id, std::size_t capacity) : tid(id), events(capacity) {}
+
+  const std::uint32_t tid; //!< Trace thread id.
+  std::vector<event> events; //!< Preallocated events storage.
+  std::atomic<std::size_t> count{0}; //!< Number of recorded events.
+  std::atomic<std::size_t> dropped{0}; //!< Number of events dropped because the buffer was full.
+  std::atomic<bool> finished{false}; //!< Set when the owning thread exits.
+  std::uint32_t depth{0}; //!< Current nesting depth, owned by the recording thread.
+};
+
+namespace detail
+{
+/**
+ * @brief Buffers of the threads that recorded events.
+ *
+ * @remark The buffers outlive their threads, so the events of finished threads can still be dumped; they are
+ * released by \ref release_finished(), once their events are dumped or cleared.
+ */
+struct registry
+{
+  std::mutex mutex;
+  std::vector<std::shared_ptr<thread_buffer>> buffers;
+  std::uint32_t nextId = 1; //!< Trace thread id of the next registered buffer.
+
+  static registry& instance()
+  {
+    static registry r;
+    return r;
+  }
+
+  /**
+   * @brief A new buffer for the calling thread: registered, or without capacity if the registry is full.
+   *
+   */
+  std::shared_ptr<thread_buffer> acquire()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (buffers.size() >= UNTANGLE_TRACE_THREADS)
+    {
+      return std::make_shared<thread_buffer>(0, 0);
+    }
+    buffers.push_back(std::make_shared<thread_buffer>(nextId++, UNTANGLE_TRACE_CAPACITY));
+    return buffers.back();
+  }
+
+  /**
+   * @brief Release the buffers of the finished threads. The mutex is held by the caller.
+   *
+   */
+  void release_finished()
+  {
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(), [](const auto& buffer)
+    {
+      return buffer->finished.load(std::memory_order_acquire);
+    }), buffers.end());
+  }
+};
+
+/**
+ * @brief Owner of the buffer of a thread, marking it finished when the thread exits.
+ *
+ */
+struct buffer_owner
+{
+  ~buffer_owner()
+  {
+    buffer->finished.store(true, std::memory_order_release);
+  }
+
+  std::shared_ptr<thread_buffer> buffer;
+};
+
+/**
+ * @brief The buffer of the calling thread, registered on first use.
+ *
+ */
+inline thread_buffer& local_buffer()
+{
+  thread_local buffer_owner owner{registry::instance().acquire()};
+  return *owner.buffer;
+}
+
+/**
+ * @brief Write a nanoseconds value as microseconds, the trace-event time unit.
+ *
+ */
+inline void write_microseconds(std::ostream& out, std::uint64_t ns)
+{
+  const auto fraction = ns % 1000;
+  out << ns / 1000 << '.' << fraction / 100 << fraction / 10 % 10 << fraction % 10;
+}
+
+/**
+ * @brief Write a string as the content of a JSON string.
+ *
+ */
+inline void write_escaped(std::ostream& out, const char* text)
+{
+  for (; *text; ++text)
+  {
+    if (*text == '"' || *text == '\\')
+    {
+      out << '\\';
+    }
+    out << (static_cast<unsigned char>(*text) < 0x20 ? '?' : *text);
+  }
+}
+
+inline std::uint64_t now()
+{
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+} // namespace detail
+
+/**
+ * @brief Records one event, from construction to destruction.
+ *
+ */
+struct scope
+{
+  /**
+   * @brief Start an event.
+   *
+   * @param actuator - Identity of the actuator.
+   * @param action - Identity of the action, or null for an emission.
+   * @param name - Emission name. It must outlive this scope.
+   * @param length - Length of the name.
+   */
+  scope(const void* actuator, const void* action, const char* name, std::size_t length)
+  : buffer(detail::local_buffer())
+  , actuator(actuator)
+  , action(action)
+  , name(name)
+  , length(length < event::nameSize ? length : event::nameSize - 1)
+  , depth(buffer.depth++)
+  , begin(detail::now())
+  {
+  }
+
+  scope(const scope&) = delete;
+  scope& operator=(const scope&) = delete;
+
+  ~scope()
+  {
+    const auto end = detail::now();
+    --buffer.depth;
+    const auto index = buffer.count.load(std::memory_order_relaxed);
+    if (index == buffer.events.size())
+    {
+      buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    auto& e = buffer.events[index];
+    e.actuator = actuator;
+    e.action = action;
+    e.begin = begin;
+    e.end = end;
+    e.depth = depth;
+    std::memcpy(e.name, name, length);
+    e.name[length] = '\0';
+    buffer.count.store(index + 1, std::memory_order_release);
+  }
+
+  private:
+  thread_buffer& buffer;
+  const void* actuator;
+  const void* action;
+  const char* name;
+  std::size_t length;
+  std::uint32_t depth;
+  std::uint64_t begin;
+};
+
+/**
+ * @brief Number of events recorded by all threads.
+ *
+ */
+inline std::size_t size()
+{
+  auto& r = detail::registry::instance();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  std::size_t total = 0;
+  for (const auto& buffer : r.buffers)
+  {
+    total += buffer->count.load(std::memory_order_acquire);
+  }
+  return total;
+}
+
+/**
+ * @brief Number of thread buffers registered: the threads emitting, and the finished ones whose events are
+ * neither dumped nor cleared.
+ *
+ */
+inline std::size_t buffers()
+{
+  auto& r = detail::registry::instance();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  return r.buffers.size();
+}
+
+/**
+ * @brief Discard all the recorded events, and release the buffers of the finished threads.
+ *
+ * @attention It must not be called while other threads are emitting.
+ */
+inline void clear()
+{
+  auto& r = detail::registry::instance();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.release_finished();
+  for (const auto& buffer : r.buffers)
+  {
+    buffer->count.store(0, std::memory_order_release);
+    buffer->dropped.store(0, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Write the recorded events to a file, in Chrome trace-event JSON format.
+ *
+ * The buffers of the finished threads are released once written: their events are dumped only once.
+ *
+ * @param path - Output file path.
+ * @return true - if the file was written.
+ * @return false - if the file could not be written.
+ */
+inline bool dump(const std::string& path)
+{
+  std::ofstream out(path, std::ios::out | std::ios::trunc);
+  if (!out)
+  {
+    return false;
+  }
+  auto& r = detail::registry::instance();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  const char* separator = "\n";
+  for (const auto& buffer : r.buffers)
+  {
+    const auto count = buffer->count.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const auto& e = buffer->events[i];
+      out << separator << "{\"name\":\"";
+      detail::write_escaped(out, e.name);
+      out << "\",\"cat\":\"" << (e.action ? "action" : "emission")
+          << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid << ",\"ts\":";
+      detail::write_microseconds(out, e.begin);
+      out << ",\"dur\":";
+      detail::write_microseconds(out, e.end - e.begin);
+      out << ",\"args\":{\"actuator\":\"" << e.actuator << "\",\"action\":\"" << e.action
+          << "\",\"depth\":" << e.depth << "}}";
+      separator = ",\n";
+    }
+    if (const auto dropped = buffer->dropped.load(std::memory_order_relaxed))
+    {
+      out << separator << "{\"name\":\"dropped\",\"ph\":\"C\",\"pid\":1,\"tid\":" << buffer->tid
+          << ",\"ts\":0,\"args\":{\"events\":" << dropped << "}}";
+      separator = ",\n";
+    }
+  }
+  out << "\n]}\n";
+  if (!out)
+  {
+    return false;
+  }
+  r.release_finished();
+  return true;
+}
+} // namespace untangle::trace
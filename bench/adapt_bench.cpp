@@ -0,0 +1,63 @@
+/**
+ * @brief Adapter benchmark: listeners of another signature, wrapped in a second std::function or adapted.
+ *
+ * @file adapt_bench.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include "bench.hpp"
+
+#include <actuator.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace untangle::bench;
+
+namespace
+{
+long total = 0;
+
+void native(int value)
+{
+  total += value;
+}
+
+// a listener taking a channel and a value, returning whether it was handled
+bool listener(int channel, int value)
+{
+  total += channel + value;
+  return true;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t count = argc > 1 ? std::stoul(argv[1]) : 1000;
+  const int rounds = 10000;
+
+  using actionT = std::function<void(int)>;
+  std::vector<actionT> natives(count, &native);
+  std::function<bool(int, int)> inner = &listener;
+  std::vector<actionT> wrapped(count, [&inner](int value) { inner(0, value); });
+  std::vector<actionT> adapted(count, untangle::adapt<actionT>(&listener, 0));
+
+  untangle::actuator<actionT> nativeActuator;
+  untangle::actuator<actionT> wrappedActuator;
+  untangle::actuator<actionT> adaptedActuator;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    nativeActuator.add(&natives[i]);
+    wrappedActuator.add(&wrapped[i]);
+    adaptedActuator.add(&adapted[i]);
+  }
+
+  std::printf("%zu actions, %d rounds\n", count, rounds);
+  report("native void(int)", measure_ms([&] { for (int r = 0; r < rounds; ++r) nativeActuator(1); }));
+  report("bool(int, int) wrapped in a second std::function", measure_ms([&]
+  {
+    for (int r = 0; r < rounds; ++r) wrappedActuator(1);
+  }));
+  report("bool(int, int) adapted", measure_ms([&] { for (int r = 0; r < rounds; ++r) adaptedActuator(1); }));
+  return total == 3 * static_cast<long>(count) * rounds ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+/**
+ * @brief Helpers shared by the actuator benchmarks.
+ *
+ * @file bench.hpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace untangle::bench {
+
+/**
+ * @brief Run a function once and return its duration in milliseconds.
+ *
+ */
+template<typename functionT>
+double measure_ms(functionT&& function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Print one benchmark result line.
+ *
+ */
+inline void report(const char* name, double ms)
+{
+  std::printf("%-48s %10.3f ms\n", name, ms);
+}
+
+} // namespace untangle::bench
@@ -0,0 +1,102 @@
+/**
+ * @brief Method group benchmark: one method over many objects, against the virtual call baseline.
+ *
+ * @file group_bench.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include "bench.hpp"
+
+#include <actuator_group.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace untangle::bench;
+
+namespace
+{
+struct shape
+{
+  virtual ~shape() = default;
+  virtual void rotate(int angle) = 0;
+};
+
+struct triangle final : shape
+{
+  void rotate(int angle) override { this->angle += angle; }
+
+  int angle = 0;
+  char payload[48] = {}; //!< Object size of a typical shape.
+};
+
+// the README baseline
+void rotate_shapes(const std::vector<shape*>& shapes, int angle)
+{
+  for (const auto& s : shapes)
+  {
+    s->rotate(angle);
+  }
+}
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+  const int rounds = 100;
+
+  std::vector<std::shared_ptr<triangle>> triangles;
+  std::vector<shape*> shapes;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    triangles.push_back(std::make_shared<triangle>());
+    shapes.push_back(triangles.back().get());
+  }
+
+  std::vector<std::function<void(int)>> bindings;
+  bindings.reserve(count);
+  for (const auto& t : triangles)
+  {
+    bindings.push_back(untangle::bind(t, &triangle::rotate));
+  }
+  untangle::actuator<std::function<void(int)>> perObject;
+  perObject.reserve(count);
+  for (auto& binding : bindings)
+  {
+    perObject.add(&binding);
+  }
+
+  std::vector<std::function<void(int)>> templateBindings;
+  templateBindings.reserve(count);
+  for (const auto& t : triangles)
+  {
+    templateBindings.push_back(untangle::bind<&triangle::rotate>(t));
+  }
+  untangle::actuator<std::function<void(int)>> perObjectTemplate;
+  perObjectTemplate.reserve(count);
+  for (auto& binding : templateBindings)
+  {
+    perObjectTemplate.add(&binding);
+  }
+
+  untangle::method_group<&triangle::rotate> group;
+  group.reserve(count);
+  for (const auto& t : triangles)
+  {
+    group.add(t.get());
+  }
+  auto groupAction = group.action();
+  untangle::actuator<std::function<void(int)>> grouped;
+  grouped.add(&groupAction);
+
+  std::printf("%zu objects, %d rounds\n", count, rounds);
+  report("virtual calls (rotate_shapes)", measure_ms([&] { for (int r = 0; r < rounds; ++r) rotate_shapes(shapes, 1); }));
+  report("actuator, one binding per object", measure_ms([&] { for (int r = 0; r < rounds; ++r) perObject(1); }));
+  report("actuator, one bind<method> per object", measure_ms([&]
+  {
+    for (int r = 0; r < rounds; ++r) perObjectTemplate(1);
+  }));
+  report("actuator, one method group", measure_ms([&] { for (int r = 0; r < rounds; ++r) grouped(1); }));
+  return triangles.front()->angle == 4 * rounds ? 0 : 1;
+}
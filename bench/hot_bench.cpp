@@ -0,0 +1,104 @@
+/**
+ * @brief Hot/cold benchmark: named invocations drawn from a Zipf distribution, with and without the hot cache.
+ *
+ * @file hot_bench.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark The names are drawn ahead, so the measures include only the invocations. With the hits tracked, the
+ * actuator is reorganized every `period` invocations, the cost of which is included.
+ */
+#include "bench.hpp"
+
+#include <actuator.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace untangle::bench;
+
+namespace
+{
+/**
+ * @brief Draw indexes in [0, count) with probabilities proportional to 1 / (rank + 1)^exponent.
+ *
+ */
+std::vector<std::size_t> zipf_indexes(std::size_t count, double exponent, std::size_t draws, std::mt19937_64& random)
+{
+  std::vector<double> weights(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    weights[i] = 1.0 / std::pow(static_cast<double>(i + 1), exponent);
+  }
+  std::discrete_distribution<std::size_t> distribution(weights.begin(), weights.end());
+  std::vector<std::size_t> indexes(draws);
+  for (auto& index : indexes)
+  {
+    index = distribution(random);
+  }
+  return indexes;
+}
+
+std::int64_t run(untangle::actuator<std::function<int(int)>>& actuator, const std::vector<const std::string*>& draws,
+                 std::size_t period)
+{
+  std::int64_t sum = 0;
+  for (std::size_t i = 0; i < draws.size(); ++i)
+  {
+    if (period > 0 && i % period == 0)
+    {
+      actuator.reorganize();
+    }
+    actuator.invokeAction(*draws[i], 1);
+    sum += actuator.results.front();
+  }
+  return sum;
+}
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t count = argc > 1 ? std::stoul(argv[1]) : 10000;
+  const double exponent = argc > 2 ? std::stod(argv[2]) : 1.1;
+  const std::size_t draws = 2000000;
+  const std::size_t period = 65536;
+
+  std::vector<std::function<int(int)>> actions;
+  std::vector<std::string> names;
+  actions.reserve(count);
+  names.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    actions.emplace_back([i](int x) { return static_cast<int>(i % 7) + x; });
+    names.push_back("action/" + std::to_string(i * 7919 % count));
+  }
+
+  // the ranks are shuffled, for the hot names to be spread over the map
+  std::mt19937_64 random(42);
+  std::vector<const std::string*> drawn;
+  drawn.reserve(draws);
+  for (const auto index : zipf_indexes(count, exponent, draws, random))
+  {
+    drawn.push_back(&names[index]);
+  }
+
+  untangle::actuator<std::function<int(int)>> cold;
+  untangle::actuator<std::function<int(int)>> hot;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    cold.add(names[i], &actions[i]);
+    hot.add(names[i], &actions[i]);
+  }
+  hot.track_hits();
+
+  std::int64_t coldSum = 0;
+  std::int64_t hotSum = 0;
+  std::printf("%zu named actions, Zipf exponent %.2f, %zu invocations, reorganized every %zu\n", count, exponent,
+              draws, period);
+  report("invokeAction, map lookup", measure_ms([&] { coldSum = run(cold, drawn, 0); }));
+  report("invokeAction, hits tracked, hot cache", measure_ms([&] { hotSum = run(hot, drawn, period); }));
+  return coldSum == hotSum ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+/**
+ * @brief Shared-memory ring benchmark: round trips between two processes.
+ *
+ * @file ipc_bench.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include "bench.hpp"
+
+#include <actuator_ipc.hpp>
+
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+
+using namespace untangle::bench;
+
+namespace
+{
+/**
+ * @brief Poll a ring until a condition holds: busy, then yielding to let the other process run on a busy machine.
+ *
+ */
+template<typename ringT, typename actuatorT, typename conditionT>
+void poll_until(ringT& ring, actuatorT& actuator, conditionT&& done)
+{
+  for (int spins = 0; !done(); ++spins)
+  {
+    if (ring.poll(actuator) == 0 && spins > 1000)
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+}
+
+int main(int argc, char* argv[])
+{
+  const int count = argc > 1 ? std::stoi(argv[1]) : 100000;
+  using actionT = std::function<void(int)>;
+  const auto ping = "/untangle_bench_ping_" + std::to_string(::getpid());
+  const auto pong = "/untangle_bench_pong_" + std::to_string(::getpid());
+
+  // both rings are created before the fork: each process keeps the publisher of one of them
+  untangle::ipc_ring<actionT> pingPublisher;
+  untangle::ipc_ring<actionT> pongPublisher;
+  if (!pingPublisher.create(ping, 64) || !pongPublisher.create(pong, 64))
+  {
+    std::printf("shared memory not available\n");
+    return 1;
+  }
+  const pid_t child = ::fork();
+  if (child == 0)
+  {
+    // echo each ping back
+    untangle::ipc_ring<actionT> pings;
+    pings.open(ping);
+    int received = -1;
+    actionT echo = [&](int id) { received = id; pongPublisher(id); };
+    auto actuator = untangle::connect(echo);
+    poll_until(pings, actuator, [&] { return received + 1 == count; });
+    ::_exit(0);
+  }
+
+  untangle::ipc_ring<actionT> pongs;
+  pongs.open(pong);
+  int last = -1;
+  actionT onPong = [&last](int id) { last = id; };
+  auto actuator = untangle::connect(onPong);
+  const auto ms = measure_ms([&]
+  {
+    for (int id = 0; id < count; ++id)
+    {
+      pingPublisher(id);
+      poll_until(pongs, actuator, [&] { return last == id; });
+    }
+  });
+  ::waitpid(child, nullptr, 0);
+  untangle::ipc_ring<actionT>::unlink(ping);
+  untangle::ipc_ring<actionT>::unlink(pong);
+
+  std::printf("%d round trips\n", count);
+  report("ping-pong", ms);
+  std::printf("%-48s %10.1f ns\n", "  one way", ms * 1e6 / (2.0 * count));
+  return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @brief Overload benchmark: a producer faster than the actions, queued with each overload policy.
+ *
+ * @file queue_bench.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark The producer pushes bursts as fast as it can, one emission in 64 being critical, and the consumer drains
+ * them through an action costing about a microsecond. The latency of the critical emissions is measured from their
+ * push to their action.
+ */
+#include "bench.hpp"
+
+#include <actuator_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using clock_type = std::chrono::steady_clock;
+
+std::int64_t now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+void run(const char* name, untangle::overload_policy policy, std::size_t capacity, std::chrono::milliseconds duration)
+{
+  std::vector<std::int64_t> latencies;
+  latencies.reserve(1u << 20);
+  std::uint64_t processed = 0;
+  std::function<void(std::int64_t, int)> action = [&](std::int64_t pushed, int critical)
+  {
+    const auto begin = now_ns();
+    while (now_ns() - begin < 1000)
+    {
+    }
+    if (critical)
+    {
+      latencies.push_back(begin - pushed);
+    }
+    ++processed;
+  };
+  auto actuator = untangle::connect(action);
+  untangle::queued<decltype(actuator)> queue(actuator, capacity, policy);
+
+  // bursts of emissions, then the producer yields the core
+  const std::uint64_t burst = 1024;
+  std::atomic<bool> stop{false};
+  std::thread producer([&]
+  {
+    for (std::uint64_t n = 0; !stop.load(std::memory_order_relaxed); ++n)
+    {
+      const bool critical = n % 64 == 0;
+      const auto priority = critical ? untangle::emission_priority::critical
+                                     : static_cast<untangle::emission_priority>(n % 3);
+      queue.push(priority, now_ns(), critical ? 1 : 0);
+      if (n % burst == burst - 1)
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::size_t maxSize = 0;
+  const auto end = clock_type::now() + duration;
+  while (clock_type::now() < end)
+  {
+    maxSize = std::max(maxSize, queue.size());
+    queue.drain(64);
+  }
+  stop = true;
+  producer.join();
+
+  std::sort(latencies.begin(), latencies.end());
+  const auto percentile = [&latencies](double p)
+  {
+    return latencies.empty() ? 0.0 : static_cast<double>(latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))]) / 1000.0;
+  };
+  std::printf("%-14s %9zu %10llu %10llu %10llu %10llu %10.1f %10.1f\n", name, maxSize,
+              static_cast<unsigned long long>(processed),
+              static_cast<unsigned long long>(queue.dropped() - queue.dropped(untangle::emission_priority::critical)),
+              static_cast<unsigned long long>(queue.dropped(untangle::emission_priority::critical)),
+              static_cast<unsigned long long>(queue.coalesced(untangle::emission_priority::low) +
+                                              queue.coalesced(untangle::emission_priority::normal) +
+                                              queue.coalesced(untangle::emission_priority::high)),
+              percentile(0.5), percentile(0.99));
+}
+}
+
+int main(int argc, char* argv[])
+{
+  const std::chrono::milliseconds duration(argc > 1 ? std::stoul(argv[1]) : 500);
+  const std::size_t capacity = argc > 2 ? std::stoul(argv[2]) : 4096;
+
+  std::printf("capacity %zu, %lld ms per policy\n", capacity, static_cast<long long>(duration.count()));
+  std::printf("%-14s %9s %10s %10s %10s %10s %10s %10s\n", "policy", "max size", "processed", "dropped",
+              "crit drop", "coalesced", "crit p50us", "crit p99us");
+  run("drop_newest", untangle::overload_policy::drop_newest, capacity, duration);
+  run("shed_lowest", untangle::overload_policy::shed_lowest, capacity, duration);
+  run("coalesce", untangle::overload_policy::coalesce, capacity, duration);
+  return 0;
+}
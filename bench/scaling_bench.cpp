@@ -0,0 +1,254 @@
+/**
+ * @brief Scaling benchmark: concurrent emitters and churners sharing one actuator.
+ *
+ * @file scaling_bench.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ *
+ * @remark An actuator is not synchronized: the threads share it through a std::shared_mutex, in two variants.
+ * - locked: the emitters hold the shared lock while the actions run;
+ * - snapshot: the emitters hold the shared lock only to copy the actuator, which shares its action table,
+ *   and invoke the copy outside the lock. The churners clone the table instead of waiting for the emissions.
+ *
+ * Each configuration checks that no action is invoked by an emission that started after its removal (dead), and
+ * that every emission invokes all the permanent actions (lost).
+ */
+#include "bench.hpp"
+
+#include <actuator.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * @brief Counters of one emitter thread, updated by the actions it invokes.
+ *
+ */
+struct emitter_counters
+{
+  std::uint64_t emissions = 0;
+  std::uint64_t permanentCalls = 0;
+  std::uint64_t dead = 0;
+  std::vector<std::uint32_t> latencies; //!< Nanoseconds per emission.
+};
+
+/**
+ * @brief Argument of an emission.
+ *
+ */
+struct emission
+{
+  std::uint64_t version; //!< Version of the actuator seen by the emission.
+  emitter_counters* counters;
+};
+
+using actionT = std::function<void(const emission&)>;
+
+/**
+ * @brief An action added and removed by a churner.
+ *
+ */
+struct churned_action
+{
+  std::atomic<std::uint64_t> removedAt{std::numeric_limits<std::uint64_t>::max()}; //!< Version of its removal.
+  actionT action;
+};
+
+struct shared_state
+{
+  std::shared_mutex mutex;
+  untangle::actuator<actionT> actuator;
+  std::uint64_t version = 0; //!< Incremented by each change of the actuator.
+  std::atomic<bool> stop{false};
+};
+
+struct result
+{
+  double emissionsPerSecond = 0;
+  std::uint32_t p50 = 0;
+  std::uint32_t p99 = 0;
+  std::uint32_t p999 = 0;
+  std::uint64_t churnOps = 0;
+  std::uint64_t dead = 0;
+  std::uint64_t lost = 0;
+};
+
+template<bool snapshot>
+void emit(shared_state& state, emitter_counters& counters)
+{
+  while (!state.stop.load(std::memory_order_relaxed))
+  {
+    const auto begin = clock_type::now();
+    if constexpr (snapshot)
+    {
+      untangle::actuator<actionT> copy;
+      std::uint64_t version;
+      {
+        std::shared_lock<std::shared_mutex> lock(state.mutex);
+        copy = state.actuator;
+        version = state.version;
+      }
+      copy(emission{version, &counters});
+    }
+    else
+    {
+      std::shared_lock<std::shared_mutex> lock(state.mutex);
+      state.actuator(emission{state.version, &counters});
+    }
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - begin).count();
+    counters.latencies.push_back(static_cast<std::uint32_t>(std::min<long long>(ns, UINT32_MAX)));
+    ++counters.emissions;
+  }
+}
+
+void churn(shared_state& state, std::vector<std::unique_ptr<churned_action>>& actions, std::uint64_t& ops)
+{
+  std::size_t next = 0;
+  while (!state.stop.load(std::memory_order_relaxed))
+  {
+    auto& churned = *actions[next++ % actions.size()];
+    {
+      std::unique_lock<std::shared_mutex> lock(state.mutex);
+      churned.removedAt.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+      state.actuator.add(&churned.action);
+      ++state.version;
+    }
+    {
+      std::unique_lock<std::shared_mutex> lock(state.mutex);
+      state.actuator.remove(&churned.action);
+      churned.removedAt.store(++state.version, std::memory_order_relaxed);
+    }
+    ops += 2;
+  }
+}
+
+template<bool snapshot>
+result run(std::size_t emitters, std::size_t churners, std::size_t permanent, std::chrono::milliseconds duration)
+{
+  shared_state state;
+  std::vector<actionT> permanentActions(permanent, [](const emission& e) { ++e.counters->permanentCalls; });
+  for (auto& action : permanentActions)
+  {
+    state.actuator.add(&action);
+  }
+
+  std::vector<std::vector<std::unique_ptr<churned_action>>> churned(churners);
+  for (auto& actions : churned)
+  {
+    for (int i = 0; i < 8; ++i)
+    {
+      auto c = std::make_unique<churned_action>();
+      c->action = [state = c.get()](const emission& e)
+      {
+        if (e.version >= state->removedAt.load(std::memory_order_relaxed))
+        {
+          ++e.counters->dead;
+        }
+      };
+      actions.push_back(std::move(c));
+    }
+  }
+
+  std::vector<emitter_counters> counters(emitters);
+  std::vector<std::uint64_t> ops(churners, 0);
+  std::vector<std::thread> threads;
+  const auto begin = clock_type::now();
+  for (std::size_t i = 0; i < emitters; ++i)
+  {
+    counters[i].latencies.reserve(1u << 20);
+    threads.emplace_back([&state, &counters, i] { emit<snapshot>(state, counters[i]); });
+  }
+  for (std::size_t i = 0; i < churners; ++i)
+  {
+    threads.emplace_back([&state, &churned, &ops, i] { churn(state, churned[i], ops[i]); });
+  }
+  std::this_thread::sleep_for(duration);
+  state.stop = true;
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  const auto seconds = std::chrono::duration<double>(clock_type::now() - begin).count();
+
+  result r;
+  std::vector<std::uint32_t> latencies;
+  std::uint64_t emissions = 0;
+  for (const auto& c : counters)
+  {
+    emissions += c.emissions;
+    r.dead += c.dead;
+    r.lost += c.emissions * permanent - c.permanentCalls;
+    latencies.insert(latencies.end(), c.latencies.begin(), c.latencies.end());
+  }
+  for (const auto o : ops)
+  {
+    r.churnOps += o;
+  }
+  r.emissionsPerSecond = static_cast<double>(emissions) / seconds;
+  if (!latencies.empty())
+  {
+    const auto percentile = [&latencies](double p)
+    {
+      const auto index = static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1));
+      std::nth_element(latencies.begin(), latencies.begin() + static_cast<std::ptrdiff_t>(index), latencies.end());
+      return latencies[index];
+    };
+    r.p50 = percentile(0.5);
+    r.p99 = percentile(0.99);
+    r.p999 = percentile(0.999);
+  }
+  return r;
+}
+
+void print(const char* variant, std::size_t emitters, std::size_t churners, const result& r)
+{
+  std::printf("%-9s %8zu %8zu %12.0f %8u %8u %8u %10llu %6llu %6llu\n", variant, emitters, churners,
+              r.emissionsPerSecond, r.p50, r.p99, r.p999, static_cast<unsigned long long>(r.churnOps),
+              static_cast<unsigned long long>(r.dead), static_cast<unsigned long long>(r.lost));
+}
+}
+
+int main(int argc, char* argv[])
+{
+  const std::chrono::milliseconds duration(argc > 1 ? std::stoul(argv[1]) : 200);
+  const std::size_t permanent = argc > 2 ? std::stoul(argv[2]) : 16;
+  const std::size_t cores = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<std::size_t> threadCounts;
+  for (std::size_t threads = 1; threads < cores; threads *= 2)
+  {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(cores);
+
+  std::printf("%zu permanent actions, %lld ms per configuration, %zu cores\n", permanent,
+              static_cast<long long>(duration.count()), cores);
+  std::printf("%-9s %8s %8s %12s %8s %8s %8s %10s %6s %6s\n", "variant", "emitters", "churners", "emissions/s",
+              "p50 ns", "p99 ns", "p999 ns", "churn ops", "dead", "lost");
+  std::uint64_t failures = 0;
+  for (const auto threads : threadCounts)
+  {
+    // a quarter of the threads churn, the others emit
+    const auto churners = threads / 4;
+    const auto emitters = threads - churners;
+    const auto locked = run<false>(emitters, churners, permanent, duration);
+    print("locked", emitters, churners, locked);
+    const auto snapshot = run<true>(emitters, churners, permanent, duration);
+    print("snapshot", emitters, churners, snapshot);
+    failures += locked.dead + locked.lost + snapshot.dead + snapshot.lost;
+  }
+  return failures == 0 ? 0 : 1;
+}
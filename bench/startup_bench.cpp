@@ -0,0 +1,96 @@
+/**
+ * @brief Startup benchmark: connecting and disconnecting large sets of actions.
+ *
+ * @file startup_bench.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include "bench.hpp"
+
+#include <actuator.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace untangle::bench;
+
+int main(int argc, char* argv[])
+{
+  const std::size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+  using actionT = std::function<void(int)>;
+  using actuatorT = untangle::actuator<actionT>;
+
+  std::vector<actionT> actions(count, [](int) {});
+  std::vector<actionT*> pointers;
+  for (auto& action : actions)
+  {
+    pointers.push_back(&action);
+  }
+  std::vector<std::pair<std::string, actionT*>> named;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    named.emplace_back("action_" + std::to_string(i), &actions[i]);
+  }
+  std::shuffle(named.begin(), named.end(), std::mt19937(42));
+  auto sortedNamed = named;
+  std::sort(sortedNamed.begin(), sortedNamed.end());
+
+  std::printf("%zu actions\n", count);
+  {
+    actuatorT actuator;
+    report("add, one at a time", measure_ms([&] { for (auto* p : pointers) actuator.add(p); }));
+  }
+  {
+    actuatorT actuator;
+    report("reserve + add, one at a time", measure_ms([&]
+    {
+      actuator.reserve(count);
+      for (auto* p : pointers) actuator.add(p);
+    }));
+  }
+  {
+    actuatorT actuator;
+    report("add_range", measure_ms([&] { actuator.add_range(pointers.begin(), pointers.end()); }));
+  }
+  {
+    actuatorT actuator;
+    report("add(name), one at a time", measure_ms([&] { for (auto& [n, p] : named) actuator.add(n, p); }));
+  }
+  {
+    actuatorT actuator;
+    report("add_range, unsorted names", measure_ms([&] { actuator.add_range(named.begin(), named.end()); }));
+  }
+  {
+    actuatorT actuator;
+    report("add_range, sorted names", measure_ms([&]
+    {
+      actuator.add_range(sortedNamed.begin(), sortedNamed.end());
+    }));
+  }
+  {
+    // removing one at a time is quadratic: measured on a smaller set
+    const std::size_t removed = std::min<std::size_t>(count, 20000);
+    actuatorT actuator;
+    actuator.add_range(pointers.begin(), pointers.begin() + static_cast<std::ptrdiff_t>(removed));
+    report("remove, one at a time (20000 max)", measure_ms([&]
+    {
+      for (std::size_t i = 0; i < removed; i += 2) actuator.remove(pointers[i]);
+    }));
+    actuator.add_range(pointers.begin(), pointers.begin() + static_cast<std::ptrdiff_t>(removed));
+    report("remove_if (20000 max)", measure_ms([&]
+    {
+      actuator.remove_if([&](const actionT* a) { return (a - actions.data()) % 2 == 0; });
+    }));
+  }
+  {
+    actuatorT actuator;
+    actuator.add_range(named.begin(), named.end());
+    report("remove_named_if", measure_ms([&]
+    {
+      actuator.remove_named_if([](const std::string& name, const actionT*) { return name.back() % 2 == 0; });
+    }));
+  }
+  return 0;
+}
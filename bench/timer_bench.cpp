@@ -0,0 +1,56 @@
+/**
+ * @brief Timer wheel benchmark: a million pending timers.
+ *
+ * @file timer_bench.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include "bench.hpp"
+
+#include <actuator_timer.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace untangle::bench;
+
+int main(int argc, char* argv[])
+{
+  const std::size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+  const auto start = untangle::timer_wheel::clock::now();
+  untangle::timer_wheel wheel(std::chrono::milliseconds(1), start);
+
+  std::size_t emitted = 0;
+  std::function<void(int)> action = [&emitted](int) { ++emitted; };
+  auto actuator = untangle::connect(action);
+
+  // delays up to one minute: the timers spread over the first three levels
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> delays(1, 60000);
+  std::vector<std::chrono::milliseconds> delay(count);
+  for (auto& d : delay)
+  {
+    d = std::chrono::milliseconds(delays(random));
+  }
+  std::vector<untangle::timer_wheel::timer_id> ids(count);
+
+  std::printf("%zu timers\n", count);
+  auto ms = measure_ms([&]
+  {
+    for (std::size_t i = 0; i < count; ++i) ids[i] = wheel.emit_after(delay[i], actuator, 1);
+  });
+  report("schedule", ms);
+  std::printf("%-48s %10.1f ns\n", "  per timer", ms * 1e6 / static_cast<double>(count));
+
+  ms = measure_ms([&] { for (std::size_t i = 0; i < count; i += 4) wheel.cancel(ids[i]); });
+  report("cancel a quarter", ms);
+  std::printf("%-48s %10.1f ns\n", "  per timer", ms * 4e6 / static_cast<double>(count));
+
+  const auto pending = wheel.size();
+  ms = measure_ms([&] { wheel.advance(start + std::chrono::milliseconds(60001)); });
+  report("advance one minute, batched expiry", ms);
+  std::printf("%-48s %10.1f ns\n", "  per expired timer", ms * 1e6 / static_cast<double>(pending));
+  std::printf("emitted %zu of %zu pending\n", emitted, pending);
+  return emitted == pending ? 0 : 1;
+}
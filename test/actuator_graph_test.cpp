@@ -0,0 +1,104 @@
+/**
+ * @brief Test the dataflow graph of actuators.
+ *
+ * @file actuator_graph_test.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include <actuator_graph.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace untangle::test {
+
+TEST(test_actuator_graph, test_diamond_updates_once) {
+  // a -> b -> d, a -> c -> d
+  std::string log;
+  std::function<void()> actionA = [&log]() { log += 'a'; };
+  std::function<void()> actionB = [&log]() { log += 'b'; };
+  std::function<void()> actionC = [&log]() { log += 'c'; };
+  std::function<void()> actionD = [&log]() { log += 'd'; };
+  auto a = untangle::connect(actionA);
+  auto b = untangle::connect(actionB);
+  auto c = untangle::connect(actionC);
+  auto d = untangle::connect(actionD);
+
+  untangle::graph g;
+  // added out of order, to exercise the topological sort
+  const auto nd = g.add(d);
+  const auto nc = g.add(c);
+  const auto nb = g.add(b);
+  const auto na = g.add(a);
+  EXPECT_TRUE(g.connect(na, nb));
+  EXPECT_TRUE(g.connect(na, nc));
+  EXPECT_TRUE(g.connect(nb, nd));
+  EXPECT_TRUE(g.connect(nc, nd));
+  EXPECT_FALSE(g.connect(nd, na));
+
+  g.mark_dirty(na);
+  g.mark_dirty(na);
+  g.mark_dirty(nb);
+  EXPECT_EQ(g.propagate(), 4);
+  ASSERT_EQ(log.size(), 4);
+  EXPECT_EQ(log.front(), 'a');
+  EXPECT_EQ(log.back(), 'd');
+
+  // only the nodes downstream of a change are updated
+  log.clear();
+  g.mark_dirty(nc);
+  EXPECT_EQ(g.propagate(), 2);
+  EXPECT_EQ(log, "cd");
+  EXPECT_EQ(g.propagate(), 0);
+
+  g.disconnect(nc, nd);
+  log.clear();
+  g.mark_dirty(nc);
+  EXPECT_EQ(g.propagate(), 1);
+  EXPECT_EQ(log, "c");
+}
+
+TEST(test_actuator_graph, test_lazy_results) {
+  int input = 1;
+  int computed = 0;
+  std::function<void()> source = []() {};
+  std::function<int()> square = [&input, &computed]() { ++computed; return input * input; };
+  auto sourceActuator = untangle::connect(source);
+  auto squareActuator = untangle::connect(square);
+
+  untangle::graph g;
+  const auto ns = g.add(sourceActuator);
+  const auto nq = g.add_lazy(squareActuator);
+  g.connect(ns, nq);
+
+  EXPECT_TRUE(g.refresh(nq));
+  EXPECT_THAT(squareActuator.results, testing::ElementsAre(1));
+  // up to date: not recomputed
+  EXPECT_FALSE(g.refresh(nq));
+  EXPECT_EQ(computed, 1);
+
+  input = 3;
+  g.mark_dirty(ns);
+  g.propagate();
+  EXPECT_TRUE(g.is_dirty(nq));
+  EXPECT_EQ(computed, 1);
+  EXPECT_TRUE(g.refresh(nq));
+  EXPECT_THAT(squareActuator.results, testing::ElementsAre(9));
+  EXPECT_EQ(computed, 2);
+
+  // an eager node downstream refreshes its lazy inputs before it is invoked
+  int seen = 0;
+  std::function<void()> consumer = [&seen, &squareActuator]() { seen = squareActuator.results.front(); };
+  auto consumerActuator = untangle::connect(consumer);
+  const auto nc = g.add(consumerActuator);
+  g.connect(nq, nc);
+  input = 4;
+  g.mark_dirty(ns);
+  g.propagate();
+  EXPECT_EQ(seen, 16);
+  EXPECT_EQ(computed, 3);
+}
+
+} // namespace untangle::test
@@ -0,0 +1,72 @@
+/**
+ * @brief Test the method groups.
+ *
+ * @file actuator_group_test.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include <actuator_group.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace untangle::test {
+
+struct wheel final
+{
+  void rotate(int angle) { this->angle += angle; }
+  void report(std::vector<int>& angles) const { angles.push_back(angle); }
+
+  int angle = 0;
+};
+
+TEST(test_actuator_group, test_group_action) {
+  // enough objects to go past the prefetch distance
+  std::vector<wheel> wheels(20);
+  untangle::method_group<&wheel::rotate> group;
+  group.reserve(wheels.size());
+  for (auto& w : wheels)
+  {
+    group.add(&w);
+  }
+  EXPECT_EQ(group.size(), wheels.size());
+
+  // the whole group is one action of the actuator
+  auto action = group.action();
+  untangle::actuator<std::function<void(int)>> actuator;
+  actuator.add(&action);
+  actuator(10);
+  actuator(5);
+  for (const auto& w : wheels)
+  {
+    EXPECT_EQ(w.angle, 15);
+  }
+
+  EXPECT_TRUE(group.remove(&wheels[3]));
+  EXPECT_FALSE(group.remove(&wheels[3]));
+  actuator(1);
+  EXPECT_EQ(wheels[3].angle, 15);
+  EXPECT_EQ(wheels[4].angle, 16);
+}
+
+TEST(test_actuator_group, test_const_method_order) {
+  std::vector<wheel> wheels(3);
+  wheels[0].angle = 1;
+  wheels[1].angle = 2;
+  wheels[2].angle = 3;
+  untangle::method_group<&wheel::report> group;
+  const wheel& last = wheels[2];
+  group.add(&last);
+  group.add(&wheels[0]);
+  group.add(&wheels[1]);
+
+  std::vector<int> angles;
+  group(angles);
+  EXPECT_THAT(angles, testing::ElementsAre(3, 1, 2));
+  group.clear();
+  EXPECT_TRUE(group.empty());
+}
+
+}
@@ -0,0 +1,225 @@
+/**
+ * @brief Test the cross-process emissions over a shared-memory ring.
+ *
+ * @file actuator_ipc_test.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include <actuator_ipc.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+#include <sys/wait.h>
+
+namespace untangle::test {
+
+using ipc_actionT = std::function<void(int, double)>;
+using ack_actionT = std::function<void(int)>;
+
+std::string ring_name(const char* test)
+{
+  return "/untangle_" + std::string(test) + "_" + std::to_string(::getpid());
+}
+
+TEST(test_actuator_ipc, test_two_processes) {
+  constexpr int count = 100000;
+  constexpr int window = 512;
+  const auto name = ring_name("data");
+  const auto ackName = ring_name("ack");
+  untangle::ipc_ring<ipc_actionT> publisher;
+  ASSERT_TRUE(publisher.create(name, 2 * window));
+  // the subscriber acknowledges the received records through a second ring, published by the child process
+  untangle::ipc_ring<ack_actionT> ackPublisher;
+  ASSERT_TRUE(ackPublisher.create(ackName, 16));
+
+  // neither process waits for the other past the deadline
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  const pid_t child = ::fork();
+  ASSERT_GE(child, 0);
+  if (child == 0)
+  {
+    // subscriber process: the exit status reports the errors
+    untangle::ipc_ring<ipc_actionT> subscriber;
+    if (!subscriber.open(name))
+    {
+      ::_exit(1);
+    }
+    int expected = 0;
+    int errors = 0;
+    ipc_actionT action = [&](int id, double value)
+    {
+      errors += (id != expected || value != id * 0.5) ? 1 : 0;
+      if (++expected % (window / 2) == 0)
+      {
+        ackPublisher(expected);
+      }
+    };
+    auto actuator = untangle::connect(action);
+    while (expected < count)
+    {
+      if (subscriber.poll(actuator) == 0)
+      {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+          ::_exit(3);
+        }
+        std::this_thread::yield();
+      }
+    }
+    ::_exit(errors == 0 && subscriber.lost() == 0 ? 0 : 2);
+  }
+
+  untangle::ipc_ring<ack_actionT> acks;
+  ASSERT_TRUE(acks.open(ackName));
+  int acknowledged = 0;
+  ack_actionT onAck = [&acknowledged](int received) { acknowledged = received; };
+  auto ackActuator = untangle::connect(onAck);
+  int status = 0;
+  bool exited = false;
+  // stay within the ring capacity ahead of the subscriber, so that nothing is overwritten; false if the
+  // subscriber exited, or stopped acknowledging until the deadline
+  const auto caughtUp = [&](int id)
+  {
+    while (id - acknowledged >= window)
+    {
+      if (acks.poll(ackActuator) > 0)
+      {
+        continue;
+      }
+      exited = ::waitpid(child, &status, WNOHANG) == child;
+      if (exited || std::chrono::steady_clock::now() > deadline)
+      {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+    return true;
+  };
+  int id = 0;
+  for (; id < count && caughtUp(id); ++id)
+  {
+    publisher(id, id * 0.5);
+  }
+  if (id < count)
+  {
+    if (!exited)
+    {
+      ::kill(child, SIGKILL);
+      ::waitpid(child, &status, 0);
+    }
+    untangle::ipc_ring<ipc_actionT>::unlink(name);
+    untangle::ipc_ring<ack_actionT>::unlink(ackName);
+    FAIL() << "the subscriber stopped acknowledging at record " << id
+           << (exited && WIFEXITED(status) ? ", exit status " + std::to_string(WEXITSTATUS(status)) : std::string());
+  }
+  ASSERT_EQ(::waitpid(child, &status, 0), child);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+  EXPECT_TRUE(untangle::ipc_ring<ipc_actionT>::unlink(name));
+  EXPECT_TRUE(untangle::ipc_ring<ack_actionT>::unlink(ackName));
+}
+
+TEST(test_actuator_ipc, test_lost_records) {
+  const auto name = ring_name("lost");
+  untangle::ipc_ring<ipc_actionT> publisher;
+  ASSERT_TRUE(publisher.create(name, 8));
+  untangle::ipc_ring<ipc_actionT> subscriber;
+  ASSERT_TRUE(subscriber.open(name));
+  // the records do not match the action arguments
+  untangle::ipc_ring<ack_actionT> mismatch;
+  EXPECT_FALSE(mismatch.open(name));
+
+  std::vector<int> received;
+  ipc_actionT action = [&received](int id, double) { received.push_back(id); };
+  auto actuator = untangle::connect(action);
+  for (int id = 0; id < 3; ++id)
+  {
+    publisher(id, 0.0);
+  }
+  EXPECT_EQ(subscriber.poll(actuator, 2), 2);
+  EXPECT_EQ(subscriber.poll(actuator), 1);
+  EXPECT_EQ(subscriber.poll(actuator), 0);
+
+  // the subscriber falls behind by more than the capacity: the overwritten records are lost
+  for (int id = 3; id < 23; ++id)
+  {
+    publisher(id, 0.0);
+  }
+  EXPECT_EQ(subscriber.poll(actuator), 8);
+  EXPECT_EQ(subscriber.lost(), 12);
+  EXPECT_EQ(received.front(), 0);
+  EXPECT_EQ(received.back(), 22);
+  EXPECT_EQ(received[3], 15);
+  EXPECT_TRUE(untangle::ipc_ring<ipc_actionT>::unlink(name));
+}
+
+TEST(test_actuator_ipc, test_reset_while_subscribed) {
+  const auto name = ring_name("reset");
+  untangle::ipc_ring<ipc_actionT> publisher;
+  ASSERT_TRUE(publisher.create(name, 8));
+  untangle::ipc_ring<ipc_actionT> subscriber;
+  ASSERT_TRUE(subscriber.open(name));
+  for (int id = 0; id < 3; ++id)
+  {
+    publisher(id, 0.0);
+  }
+
+  // the reset replaces the ring: the former one is left intact for its subscribers
+  ASSERT_TRUE(publisher.create(name, 8));
+  publisher(10, 0.0);
+  std::vector<int> received;
+  ipc_actionT action = [&received](int id, double) { received.push_back(id); };
+  auto actuator = untangle::connect(action);
+  EXPECT_EQ(subscriber.poll(actuator), 3);
+  EXPECT_EQ(subscriber.poll(actuator), 0);
+  EXPECT_EQ(subscriber.lost(), 0);
+
+  // opened again, the subscriber follows the new ring
+  ASSERT_TRUE(subscriber.open(name));
+  publisher(11, 0.0);
+  EXPECT_EQ(subscriber.poll(actuator), 2);
+  EXPECT_THAT(received, testing::ElementsAre(0, 1, 2, 10, 11));
+  EXPECT_TRUE(untangle::ipc_ring<ipc_actionT>::unlink(name));
+}
+
+TEST(test_actuator_ipc, test_publisher_died_writing) {
+  constexpr std::size_t capacity = 4;
+  const auto name = ring_name("died");
+  untangle::ipc_ring<ipc_actionT> publisher;
+  ASSERT_TRUE(publisher.create(name, capacity));
+  untangle::ipc_ring<ipc_actionT> subscriber;
+  ASSERT_TRUE(subscriber.open(name));
+  for (int id = 1; id <= 4; ++id)
+  {
+    publisher(id, 0.0);
+  }
+
+  // the publisher started to overwrite the record 1 with the record 5, and died: its sequence stays 0
+  using argumentsT = untangle::ipc_ring<ipc_actionT>::argumentsT;
+  const auto bytes = untangle::detail::ring_record_offset<argumentsT>(capacity);
+  const int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+  ASSERT_GE(fd, 0);
+  void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  ASSERT_NE(mapping, MAP_FAILED);
+  auto* record = static_cast<char*>(mapping) + untangle::detail::ring_record_offset<argumentsT>(5 % capacity);
+  reinterpret_cast<untangle::detail::ring_record*>(record)->sequence.store(0);
+  ::munmap(mapping, bytes);
+
+  // the record is lost, the poll does not wait for it
+  std::vector<int> received;
+  ipc_actionT action = [&received](int id, double) { received.push_back(id); };
+  auto actuator = untangle::connect(action);
+  EXPECT_EQ(subscriber.poll(actuator), 3);
+  EXPECT_EQ(subscriber.lost(), 1);
+  EXPECT_THAT(received, testing::ElementsAre(2, 3, 4));
+  EXPECT_EQ(subscriber.poll(actuator), 0);
+  EXPECT_TRUE(untangle::ipc_ring<ipc_actionT>::unlink(name));
+}
+
+}
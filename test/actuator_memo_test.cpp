@@ -0,0 +1,96 @@
+/**
+ * @brief Test the memoization of actuator results.
+ *
+ * @file actuator_memo_test.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include <actuator_memo.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace untangle::test {
+
+TEST(test_actuator_memo, test_cached_results) {
+  int calls = 0;
+  int scale = 2;
+  std::function<int(int, int)> multiply = [&](int a, int b) { ++calls; return a * b * scale; };
+  std::function<int(int, int)> add = [&](int a, int b) { ++calls; return a + b; };
+  auto actuator = untangle::connect(multiply, add);
+  untangle::memoized<decltype(actuator)> memo(actuator, 2);
+
+  EXPECT_THAT(memo(2, 3), testing::ElementsAre(12, 5));
+  EXPECT_THAT(memo(2, 3), testing::ElementsAre(12, 5));
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(memo.hits(), 1);
+
+  // least recently used evicted: (4, 5) then (2, 3) are kept
+  memo(1, 1);
+  memo(4, 5);
+  memo(2, 3);
+  EXPECT_EQ(memo.size(), 2);
+  EXPECT_EQ(calls, 8);
+  memo(4, 5);
+  EXPECT_EQ(calls, 8);
+
+  // the objects read by the actions changed
+  scale = 10;
+  EXPECT_TRUE(memo.invalidate(2, 3));
+  EXPECT_FALSE(memo.invalidate(2, 3));
+  EXPECT_THAT(memo(2, 3), testing::ElementsAre(60, 5));
+  memo.invalidate();
+  EXPECT_EQ(memo.size(), 0);
+  EXPECT_THAT(memo(4, 5), testing::ElementsAre(200, 9));
+}
+
+TEST(test_actuator_memo, test_actions_changed) {
+  std::function<int(int)> twice = [](int a) { return 2 * a; };
+  std::function<int(int)> square = [](int a) { return a * a; };
+  auto actuator = untangle::connect(twice);
+  untangle::memoized<decltype(actuator)> memo(actuator);
+
+  EXPECT_THAT(memo(3), testing::ElementsAre(6));
+  actuator.add(&square);
+  EXPECT_THAT(memo(3), testing::ElementsAre(6, 9));
+  EXPECT_EQ(memo.hits(), 0);
+
+  // a copy sharing the actions keeps the cache
+  auto copy = actuator;
+  EXPECT_EQ(copy.revision(), actuator.revision());
+  EXPECT_THAT(memo(3), testing::ElementsAre(6, 9));
+  EXPECT_EQ(memo.hits(), 1);
+
+  actuator.remove(&twice);
+  EXPECT_THAT(memo(3), testing::ElementsAre(9));
+}
+
+struct gauge
+{
+  int scale;
+  int read(int x) const { return scale * x; }
+};
+
+TEST(test_actuator_memo, test_dead_binding_dropped) {
+  auto first = std::make_shared<gauge>(gauge{2});
+  const auto second = std::make_shared<gauge>(gauge{3});
+  auto action1 = untangle::bind(first, &gauge::read);
+  auto action2 = untangle::bind(second, &gauge::read);
+  auto actuator = untangle::connect(action1, action2);
+  untangle::memoized<decltype(actuator)> memo(actuator);
+
+  EXPECT_THAT(memo(1), testing::ElementsAre(2, 3));
+  const auto revision = actuator.revision();
+
+  // the miss drops the dead binding, without changing the revision: its results are cached, the former ones not
+  first.reset();
+  EXPECT_THAT(memo(2), testing::ElementsAre(6));
+  EXPECT_EQ(actuator.revision(), revision);
+  EXPECT_EQ(memo.size(), 1);
+  EXPECT_THAT(memo(1), testing::ElementsAre(3));
+  EXPECT_THAT(memo(2), testing::ElementsAre(6));
+  EXPECT_EQ(memo.misses(), 3);
+  EXPECT_EQ(memo.hits(), 1);
+}
+
+}
@@ -0,0 +1,56 @@
+/**
+ * @brief Test the actuator pipelines.
+ *
+ * @file actuator_pipeline_test.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include <actuator_pipeline.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace untangle::test {
+
+TEST(test_actuator_pipeline, test_three_stages) {
+  std::function<int(int)> plusOne = [](int x) { return x + 1; };
+  std::function<int(int)> timesTwo = [](int x) { return x * 2; };
+  std::function<int(int)> timesTen = [](int x) { return x * 10; };
+  std::function<std::string(int)> print = [](int x) { return std::to_string(x); };
+
+  auto first = untangle::connect(plusOne, timesTwo);
+  auto second = untangle::connect(timesTen, plusOne);
+  auto third = untangle::connect(print);
+
+  auto stages = first | second | third;
+  stages(3);
+
+  // every result of a stage goes through every action of the next one
+  EXPECT_THAT(third.results, testing::ElementsAre("40", "5", "60", "7"));
+  // the intermediate stages collect nothing
+  EXPECT_TRUE(first.results.empty());
+  EXPECT_TRUE(second.results.empty());
+
+  std::vector<std::string> streamed;
+  stages.into([&streamed](std::string result) { streamed.push_back(std::move(result)); }, 1);
+  EXPECT_THAT(streamed, testing::ElementsAre("20", "3", "20", "3"));
+}
+
+TEST(test_actuator_pipeline, test_void_last_stage) {
+  std::function<int(int)> square = [](int x) { return x * x; };
+  int total = 0;
+  std::function<void(int)> accumulate = [&total](int x) { total += x; };
+
+  auto first = untangle::connect(square);
+  auto last = untangle::connect(accumulate);
+  auto stages = first | last;
+  stages(4);
+  stages(5);
+  EXPECT_EQ(total, 41);
+
+  int count = 0;
+  stages.into([&count]() { ++count; }, 1);
+  EXPECT_EQ(count, 1);
+}
+
+} // namespace untangle::test
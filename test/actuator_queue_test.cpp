@@ -0,0 +1,125 @@
+/**
+ * @brief Test the bounded queues of emissions.
+ *
+ * @file actuator_queue_test.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include <actuator_queue.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace untangle::test {
+
+using untangle::emission_priority;
+
+TEST(test_actuator_queue, test_shed_lowest) {
+  std::vector<int> emitted;
+  std::function<void(int)> record = [&emitted](int value) { emitted.push_back(value); };
+  auto actuator = untangle::connect(record);
+  untangle::queued<decltype(actuator)> queue(actuator, 3);
+
+  EXPECT_TRUE(queue.push(emission_priority::low, 1));
+  EXPECT_TRUE(queue.push(emission_priority::normal, 2));
+  EXPECT_TRUE(queue.push(emission_priority::low, 3));
+  // full: the oldest low emission is shed for a higher one, a low one is dropped
+  EXPECT_TRUE(queue.push(emission_priority::critical, 4));
+  EXPECT_FALSE(queue.push(emission_priority::low, 5));
+  EXPECT_EQ(queue.size(), 3);
+  EXPECT_EQ(queue.dropped(emission_priority::low), 2);
+  EXPECT_EQ(queue.dropped(emission_priority::critical), 0);
+
+  // by priority, then in order
+  EXPECT_EQ(queue.drain(), 3);
+  EXPECT_THAT(emitted, testing::ElementsAre(4, 2, 3));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(test_actuator_queue, test_drop_newest_and_coalesce) {
+  std::vector<int> emitted;
+  std::function<void(int)> record = [&emitted](int value) { emitted.push_back(value); };
+  auto actuator = untangle::connect(record);
+
+  untangle::queued<decltype(actuator)> tail(actuator, 2, untangle::overload_policy::drop_newest);
+  tail.push(emission_priority::low, 1);
+  tail.push(emission_priority::low, 2);
+  EXPECT_FALSE(tail.push(emission_priority::critical, 3));
+  EXPECT_EQ(tail.dropped(emission_priority::critical), 1);
+  EXPECT_EQ(tail.drain(1), 1);
+  EXPECT_THAT(emitted, testing::ElementsAre(1));
+  tail.drain();
+  emitted.clear();
+
+  // the newest emission of the same priority takes the incoming arguments
+  untangle::queued<decltype(actuator)> latest(actuator, 2, untangle::overload_policy::coalesce);
+  latest.push(emission_priority::normal, 1);
+  latest.push(emission_priority::normal, 2);
+  EXPECT_TRUE(latest.push(emission_priority::normal, 3));
+  EXPECT_FALSE(latest.push(emission_priority::low, 4));
+  EXPECT_EQ(latest.coalesced(emission_priority::normal), 1);
+  EXPECT_EQ(latest.dropped(), 1);
+  latest.drain();
+  EXPECT_THAT(emitted, testing::ElementsAre(1, 3));
+}
+
+TEST(test_actuator_queue, test_drain_to_several_actions) {
+  std::vector<std::string> emitted;
+  std::function<void(std::string)> first = [&emitted](std::string value) { emitted.push_back(value); };
+  std::function<void(std::string)> second = [&emitted](std::string value) { emitted.push_back(value); };
+  auto actuator = untangle::connect(first, second);
+  untangle::queued<decltype(actuator)> queue(actuator, 2);
+
+  queue.push(emission_priority::normal, std::string("hello"));
+  EXPECT_EQ(queue.drain(), 1);
+  // the second action does not receive moved-from arguments
+  EXPECT_THAT(emitted, testing::ElementsAre("hello", "hello"));
+}
+
+TEST(test_actuator_queue, test_concurrent_producers) {
+  constexpr int producers = 4;
+  constexpr int pushes = 10000;
+  std::atomic<int> received{0};
+  std::function<void(int)> count = [&received](int) { ++received; };
+  auto actuator = untangle::connect(count);
+  untangle::queued<decltype(actuator)> queue(actuator, 64, untangle::overload_policy::coalesce);
+
+  std::atomic<int> done{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < producers; ++i)
+  {
+    threads.emplace_back([&queue, &done, i]
+    {
+      for (int n = 0; n < pushes; ++n)
+      {
+        queue.push(static_cast<emission_priority>((n + i) % 4), n);
+      }
+      ++done;
+    });
+  }
+  while (done < producers)
+  {
+    queue.drain(16);
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  queue.drain();
+
+  std::uint64_t coalesced = 0;
+  for (const auto priority : {emission_priority::low, emission_priority::normal, emission_priority::high,
+                              emission_priority::critical})
+  {
+    coalesced += queue.coalesced(priority);
+  }
+  // every push is emitted, dropped, or coalesced
+  EXPECT_EQ(received + queue.dropped() + coalesced, producers * pushes);
+}
+
+}
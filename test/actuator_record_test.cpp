@@ -0,0 +1,198 @@
+/**
+ * @brief Test the record and replay of actuator emissions.
+ *
+ * @file actuator_record_test.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include <actuator_record.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+namespace untangle::test {
+
+TEST(test_actuator_record, test_record_replay) {
+  const std::string path = testing::TempDir() + "actuator_record_test.log";
+
+  std::vector<std::pair<int, std::string>> received;
+  std::function<void(int, const std::string&)> action = [&received](int id, const std::string& text)
+  {
+    received.emplace_back(id, text);
+  };
+
+  {
+    untangle::actuator<std::function<void(int, const std::string&)>> actuator;
+    actuator.add(&action);
+    actuator.add("named", &action);
+
+    untangle::recorder log;
+    ASSERT_TRUE(log.open(path, 64));
+    untangle::recorded<decltype(actuator)> recorded(actuator, log);
+    recorded(1, std::string("one"));
+    recorded.invokeAction("named", 2, std::string("two"));
+    // the log grows past its initial size
+    recorded(3, std::string(200, 'x'));
+  }
+  EXPECT_EQ(received.size(), 3);
+  auto recorded = received;
+  received.clear();
+
+  // replay against a rebuilt actuator
+  untangle::actuator<std::function<void(int, const std::string&)>> actuator;
+  actuator.add(&action);
+  actuator.add("named", &action);
+
+  untangle::replay_log log;
+  ASSERT_TRUE(log.open(path));
+  EXPECT_EQ(log.size(), 3);
+  EXPECT_EQ(log.replay(actuator), 3);
+  EXPECT_EQ(received, recorded);
+  std::remove(path.c_str());
+}
+
+TEST(test_actuator_record, test_replay_original_pacing) {
+  const std::string path = testing::TempDir() + "actuator_record_pacing_test.log";
+
+  int total = 0;
+  std::function<void(int)> action = [&total](int value) { total += value; };
+  untangle::actuator<std::function<void(int)>> actuator;
+  actuator.add(&action);
+
+  {
+    untangle::recorder log;
+    ASSERT_TRUE(log.open(path));
+    untangle::recorded<decltype(actuator)> recorded(actuator, log);
+    recorded(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    recorded(2);
+  }
+
+  untangle::replay_log log;
+  ASSERT_TRUE(log.open(path));
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(log.replay(actuator, untangle::pacing::original), 2);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+  EXPECT_EQ(total, 6);
+  std::remove(path.c_str());
+}
+
+TEST(test_actuator_record, test_replay_other_arguments) {
+  const std::string path = testing::TempDir() + "actuator_record_arguments_test.log";
+
+  std::function<void(int)> action = [](int) {};
+  untangle::actuator<std::function<void(int)>> actuator;
+  actuator.add(&action);
+  {
+    untangle::recorder log;
+    ASSERT_TRUE(log.open(path));
+    untangle::recorded<decltype(actuator)> recorded(actuator, log);
+    recorded(1);
+    // the records of a log have the same argument types
+    EXPECT_FALSE(log.record(untangle::record_kind::call, std::string(), std::string("one")));
+    // the name length must fit in the record header
+    EXPECT_FALSE(log.record(untangle::record_kind::invoke_action, std::string(70000, 'n'), 2));
+  }
+
+  int received = 0;
+  std::function<void(const std::string&)> other = [&received](const std::string&) { ++received; };
+  untangle::actuator<std::function<void(const std::string&)>> otherActuator;
+  otherActuator.add(&other);
+
+  untangle::replay_log log;
+  ASSERT_TRUE(log.open(path));
+  EXPECT_EQ(log.size(), 1);
+  EXPECT_TRUE(log.compatible(actuator));
+  EXPECT_FALSE(log.compatible(otherActuator));
+  EXPECT_EQ(log.replay(otherActuator), 0);
+  EXPECT_EQ(received, 0);
+  std::remove(path.c_str());
+}
+
+struct point
+{
+  std::int32_t x;
+  std::int32_t y;
+};
+
+struct extent
+{
+  float width;
+  float height;
+};
+
+TEST(test_actuator_record, test_replay_other_struct) {
+  const std::string path = testing::TempDir() + "actuator_record_struct_test.log";
+
+  std::function<void(point)> action = [](point) {};
+  untangle::actuator<std::function<void(point)>> actuator;
+  actuator.add(&action);
+  {
+    untangle::recorder log;
+    ASSERT_TRUE(log.open(path));
+    untangle::recorded<decltype(actuator)> recorded(actuator, log);
+    recorded(point{1, 2});
+    // a structure of the same size is another type
+    EXPECT_FALSE(log.record(untangle::record_kind::call, std::string(), extent{1.0f, 2.0f}));
+  }
+
+  int received = 0;
+  std::function<void(extent)> other = [&received](extent) { ++received; };
+  untangle::actuator<std::function<void(extent)>> otherActuator;
+  otherActuator.add(&other);
+
+  untangle::replay_log log;
+  ASSERT_TRUE(log.open(path));
+  EXPECT_EQ(log.size(), 1);
+  EXPECT_TRUE(log.compatible(actuator));
+  EXPECT_FALSE(log.compatible(otherActuator));
+  EXPECT_EQ(log.replay(otherActuator), 0);
+  EXPECT_EQ(received, 0);
+  std::remove(path.c_str());
+}
+
+TEST(test_actuator_record, test_replay_malformed_record) {
+  const std::string path = testing::TempDir() + "actuator_record_malformed_test.log";
+
+  int received = 0;
+  std::function<void(int, const std::string&)> action = [&received](int, const std::string&) { ++received; };
+  untangle::actuator<std::function<void(int, const std::string&)>> actuator;
+  actuator.add(&action);
+  {
+    untangle::recorder log;
+    ASSERT_TRUE(log.open(path));
+    untangle::recorded<decltype(actuator)> recorded(actuator, log);
+    recorded(1, std::string("one"));
+    recorded(2, std::string("two"));
+  }
+  received = 0;
+
+  // the length of the second string overflows its record
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    const auto recordSize = untangle::detail::align(sizeof(untangle::detail::record_header) + sizeof(int) +
+                                                    sizeof(std::uint64_t) + 3);
+    file.seekp(static_cast<std::streamoff>(sizeof(untangle::detail::log_header) + recordSize +
+                                           sizeof(untangle::detail::record_header) + sizeof(int)));
+    const std::uint64_t length = 1 << 30;
+    file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+  }
+
+  untangle::replay_log log;
+  ASSERT_TRUE(log.open(path));
+  EXPECT_EQ(log.size(), 2);
+  EXPECT_EQ(log.replay(actuator), 1);
+  EXPECT_EQ(received, 1);
+  std::remove(path.c_str());
+}
+
+TEST(test_actuator_record, test_invalid_log) {
+  untangle::replay_log log;
+  EXPECT_FALSE(log.open(testing::TempDir() + "actuator_record_missing.log"));
+  EXPECT_EQ(log.size(), 0);
+}
+
+} // namespace untangle::test
@@ -10,6 +10,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <list>
+#include <memory_resource>
+
 namespace untangle::test {
 
 class shape
@@ -273,6 +276,111 @@ TEST(test_actuator, test_assignment) {
   testing::Mock::VerifyAndClearExpectations(s.get());
 }
 
+TEST(test_actuator, test_copy_on_write) {
+  const auto t = std::make_shared<triangle_mock>();
+  const auto c = std::make_shared<circle_mock>();
+  const auto s = std::make_shared<square_mock>();
+
+  auto action1 = untangle::bind(t, &triangle_mock::rotate);
+  auto action2 = untangle::bind(c, &circle_mock::rotate);
+  auto action3 = untangle::bind(s, &square_mock::rotate);
+
+  auto actuator_rotate = untangle::connect(action1, action2);
+  auto actuator_rotate_1 = actuator_rotate;
+
+  // copies share the same action table
+  EXPECT_EQ(&actuator_rotate.actions(), &actuator_rotate_1.actions());
+
+  // mutating a copy detaches it, the original is left untouched
+  actuator_rotate_1.add(&action3);
+  EXPECT_NE(&actuator_rotate.actions(), &actuator_rotate_1.actions());
+  EXPECT_EQ(actuator_rotate.actions().size(), 2);
+  EXPECT_EQ(actuator_rotate_1.actions().size(), 3);
+
+  EXPECT_CALL(*t, rotate(10)).WillOnce(testing::Return());
+  EXPECT_CALL(*c, rotate(10)).WillOnce(testing::Return());
+  EXPECT_CALL(*s, rotate(testing::_)).Times(0);
+  actuator_rotate(10);
+  testing::Mock::VerifyAndClearExpectations(t.get());
+  testing::Mock::VerifyAndClearExpectations(c.get());
+  testing::Mock::VerifyAndClearExpectations(s.get());
+
+  EXPECT_CALL(*t, rotate(20)).WillOnce(testing::Return());
+  EXPECT_CALL(*c, rotate(20)).WillOnce(testing::Return());
+  EXPECT_CALL(*s, rotate(20)).WillOnce(testing::Return());
+  actuator_rotate_1(20);
+  testing::Mock::VerifyAndClearExpectations(t.get());
+  testing::Mock::VerifyAndClearExpectations(c.get());
+  testing::Mock::VerifyAndClearExpectations(s.get());
+}
+
+TEST(test_actuator, test_drop_invalid_action_in_place) {
+  auto t = std::make_shared<triangle>();
+  const auto c = std::make_shared<circle>();
+  auto action1 = untangle::bind(t, &triangle::height_out);
+  auto action2 = untangle::bind(c, &circle::height_out);
+  auto named1 = untangle::bind(t, &triangle::height_out);
+
+  untangle::actuator<std::function<int()>> actuator;
+  actuator.add(&action1);
+  actuator.add(&action2);
+  actuator.add("triangle", &named1);
+  actuator.add("circle", &action2);
+  const auto revision = actuator.revision();
+  const auto* actions = &actuator.actions();
+  const auto* named = &actuator.mapActions();
+
+  // an actuator that does not share its table drops the dead binding in place
+  t.reset();
+  actuator();
+  EXPECT_EQ(actuator.actions().size(), 1);
+  EXPECT_EQ(&actuator.actions(), actions);
+  EXPECT_EQ(actuator.revision(), revision);
+
+  EXPECT_EQ(actuator.invokeAction("triangle"), untangle::action_status::invalid);
+  EXPECT_FALSE(actuator.has_action("triangle"));
+  EXPECT_EQ(&actuator.mapActions(), named);
+  EXPECT_EQ(actuator.revision(), revision);
+
+  // a shared table is cloned, the copy keeps its own
+  auto copy = actuator;
+  c->height_in(20);
+  auto dead = std::make_shared<triangle>();
+  auto action3 = untangle::bind(dead, &triangle::height_out);
+  copy.add(&action3);
+  auto shared = copy;
+  dead.reset();
+  copy();
+  EXPECT_EQ(copy.actions().size(), 1);
+  EXPECT_EQ(shared.actions().size(), 2);
+  EXPECT_NE(&copy.actions(), &shared.actions());
+}
+
+TEST(test_actuator, test_remove_while_invoked) {
+  const auto t = std::make_shared<triangle_mock>();
+  const auto c = std::make_shared<circle_mock>();
+
+  auto action2 = untangle::bind(c, &circle_mock::rotate);
+  untangle::actuator<std::function<void(int)>> actuator_rotate;
+  // an action removing itself while the actuator is invoked
+  std::function<void(int)> action1 = [&](int angle)
+  {
+    t->rotate(angle);
+    actuator_rotate.remove(&action1);
+  };
+  actuator_rotate.add(&action1);
+  actuator_rotate.add(&action2);
+
+  EXPECT_CALL(*t, rotate(30)).WillOnce(testing::Return());
+  EXPECT_CALL(*c, rotate(testing::_)).Times(2).WillRepeatedly(testing::Return());
+  actuator_rotate(30);
+  actuator_rotate(40);
+  EXPECT_EQ(actuator_rotate.actions().size(), 1);
+
+  testing::Mock::VerifyAndClearExpectations(t.get());
+  testing::Mock::VerifyAndClearExpectations(c.get());
+}
+
 TEST(test_actuator, test_add) {
   const auto t = std::make_shared<triangle_mock>();
   const auto c = std::make_shared<circle_mock>();
@@ -367,6 +475,603 @@ TEST(test_actuator, test_invalid_action) {
   testing::Mock::VerifyAndClearExpectations(s.get());
 }
 
+TEST(test_actuator, test_invalid_action_status) {
+  auto t = std::make_shared<triangle>();
+  const auto c = std::make_shared<circle>();
+  t->height_in(10);
+  c->height_in(20);
+
+  auto action1 = untangle::bind(t, &triangle::height_out);
+  auto action2 = untangle::bind(c, &circle::height_out);
+
+  untangle::actuator<std::function<int()>> actuator;
+  actuator.add("triangle", &action1);
+  actuator.add("circle", &action2);
+  actuator.add(&action1);
+  actuator.add(&action2);
+
+  EXPECT_EQ(actuator.invokeAction("triangle"), untangle::action_status::invoked);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(10));
+  EXPECT_EQ(actuator.invokeAction("square"), untangle::action_status::not_found);
+
+  // a dead binding leaves no result behind, with or without exceptions
+  t.reset();
+  EXPECT_EQ(actuator.invokeAction("triangle"), untangle::action_status::invalid);
+  EXPECT_TRUE(actuator.results.empty());
+  EXPECT_FALSE(actuator.has_action("triangle"));
+  EXPECT_EQ(actuator.invokeAction("triangle"), untangle::action_status::not_found);
+
+  actuator();
+  EXPECT_THAT(actuator.results, testing::ElementsAre(20));
+  EXPECT_EQ(actuator.actions().size(), 1);
+}
+
+TEST(test_actuator, test_stale_invalid_action) {
+  auto t = std::make_shared<triangle>();
+  auto dead = untangle::bind(t, &triangle::height_out);
+  t.reset();
+#if UNTANGLE_EXCEPTIONS
+  EXPECT_THROW(dead(), untangle::invalid_action);
+#else
+  // called outside of an actuator: the reason is left behind
+  EXPECT_EQ(dead(), 0);
+#endif
+
+  int calls = 0;
+  std::function<void()> valid = [&calls]() { ++calls; };
+  untangle::actuator<std::function<void()>> actuator;
+  actuator.add(&valid);
+  actuator();
+  EXPECT_EQ(calls, 1);
+  EXPECT_TRUE(valid != nullptr);
+  EXPECT_EQ(actuator.actions().size(), 1);
+}
+
+TEST(test_actuator, test_bind_template_method) {
+  auto t = std::make_shared<triangle_mock>();
+  const auto c = std::make_shared<circle>();
+
+  const auto binding = untangle::bind<&triangle_mock::rotate>(t);
+  static_assert(sizeof(binding) == sizeof(void*));
+  std::function<void(int)> action1 = binding;
+  std::function<void(int)> action2 = untangle::bind<&circle::rotate>(c.get());
+  std::function<void(int)> action3 = untangle::bind<&circle::height_in>(c);
+  std::function<int()> action4 = untangle::bind<&circle::height_out>(c);
+
+  auto actuator_rotate = untangle::connect(action1, action2, action3);
+  EXPECT_CALL(*t, rotate(30)).WillOnce(testing::Return());
+  actuator_rotate(30);
+  testing::Mock::VerifyAndClearExpectations(t.get());
+  EXPECT_EQ(action4(), 30);
+
+  // the binding refers to the shared pointer: resetting it invalidates the action
+  t.reset();
+  actuator_rotate(40);
+  EXPECT_EQ(actuator_rotate.actions().size(), 2);
+  EXPECT_EQ(action4(), 40);
+}
+
+TEST(test_actuator, test_emit_within) {
+  std::vector<int> calls;
+  std::function<int(int)> essential1 = [&calls](int x) { calls.push_back(1); return x + 1; };
+  std::function<int(int)> optional2 = [&calls](int x) { calls.push_back(2); return x + 2; };
+  std::function<int(int)> essential3 = [&calls](int x) { calls.push_back(3); return x + 3; };
+  std::function<int(int)> optional4 = [&calls](int x) { calls.push_back(4); return x + 4; };
+
+  untangle::actuator<std::function<int(int)>> actuator;
+  actuator.add(&essential1);
+  actuator.add(&optional2, untangle::action_priority::optional);
+  actuator.add(&essential3, untangle::action_priority::essential);
+  actuator.add(&optional4, untangle::action_priority::optional, untangle::key_filter::key(7));
+
+  // within the budget, all the actions run
+  auto report = actuator.emit_within(std::chrono::hours(1), 10);
+  EXPECT_EQ(report.invoked, 4);
+  EXPECT_TRUE(report.skipped.empty());
+  EXPECT_THAT(actuator.results, testing::ElementsAre(11, 12, 13, 14));
+
+  // the budget is exhausted: only the essential actions run
+  calls.clear();
+  report = actuator.emit_within(std::chrono::nanoseconds(0), 10);
+  EXPECT_EQ(report.invoked, 2);
+  EXPECT_THAT(report.skipped, testing::ElementsAre(&optional2, &optional4));
+  EXPECT_THAT(calls, testing::ElementsAre(1, 3));
+  EXPECT_THAT(actuator.results, testing::ElementsAre(11, 13));
+
+  // the priorities follow the actions when others are removed
+  actuator.remove(&essential1);
+  report = actuator.emit_within(std::chrono::nanoseconds(0), 10);
+  EXPECT_THAT(report.skipped, testing::ElementsAre(&optional2, &optional4));
+  EXPECT_THAT(actuator.results, testing::ElementsAre(13));
+
+  // the other emissions ignore the priorities
+  actuator(10);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(12, 13, 14));
+}
+
+TEST(test_actuator, test_emit_lazy) {
+  int built = 0;
+  const auto factory = [&built]() { ++built; return std::string(1000, 'x'); };
+
+  std::vector<std::size_t> sizes;
+  std::function<std::size_t(const std::string&)> action = [&sizes](const std::string& text)
+  {
+    sizes.push_back(text.size());
+    return text.size();
+  };
+  untangle::actuator<std::function<std::size_t(const std::string&)>> actuator;
+
+  // nobody is listening: the payload is not built
+  EXPECT_FALSE(actuator.emit_lazy(factory));
+  EXPECT_EQ(actuator.emit_lazy("named", factory), untangle::action_status::not_found);
+  std::function<std::size_t(const std::string&)> empty;
+  actuator.add(&empty);
+  EXPECT_FALSE(actuator.emit_lazy(factory));
+  EXPECT_EQ(built, 0);
+
+  // built once, shared by all the actions
+  actuator.add(&action);
+  actuator.add(&action);
+  EXPECT_TRUE(actuator.emit_lazy(factory));
+  EXPECT_EQ(built, 1);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(1000, 1000));
+  EXPECT_EQ(actuator.actions().size(), 2);
+
+  actuator.add("named", &action);
+  EXPECT_EQ(actuator.emit_lazy("named", factory), untangle::action_status::invoked);
+  EXPECT_EQ(built, 2);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(1000));
+
+  // several arguments are built as a tuple
+  std::function<void(int, const std::string&)> action2 = [&sizes](int n, const std::string& text)
+  {
+    sizes.push_back(n + text.size());
+  };
+  auto actuator2 = untangle::connect(action2);
+  EXPECT_TRUE(actuator2.emit_lazy([]() { return std::make_tuple(5, std::string("abc")); }));
+  EXPECT_EQ(sizes.back(), 8);
+}
+
+TEST(test_actuator, test_emit_rvalue_to_several_actions) {
+  std::vector<std::string> received;
+  std::function<void(std::string)> action1 = [&received](std::string text) { received.push_back(text); };
+  std::function<void(std::string)> action2 = [&received](std::string text) { received.push_back(text); };
+  auto actuator = untangle::connect(action1, action2);
+
+  // the second action does not receive a moved-from argument
+  actuator(std::string("hello"));
+  EXPECT_THAT(received, testing::ElementsAre("hello", "hello"));
+}
+
+TEST(test_actuator, test_invoke_actions) {
+  constexpr int count = 100;
+  std::vector<std::function<int(int)>> actions;
+  actions.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    actions.emplace_back([i](int x) { return i * 1000 + x; });
+  }
+
+  for (const int size : {10, count})
+  {
+    auto t = std::make_shared<triangle>();
+    auto dead = untangle::bind(t, &triangle::height_out);
+    std::function<int(int)> deadAction = [&dead](int) { return dead(); };
+    t.reset();
+
+    untangle::actuator<std::function<int(int)>> actuator;
+    for (int i = 0; i < size; ++i)
+    {
+      actuator.add("action" + std::to_string(i), &actions[i]);
+    }
+    actuator.add("dead", &deadAction);
+
+    // merged with the map when the names are many compared to it, looked up one by one otherwise
+    const std::vector<std::string> names = {"action7", "missing", "action3", "dead", "action7", "action0"};
+    const auto statuses = actuator.invokeActions(names, 5);
+    EXPECT_THAT(statuses, testing::ElementsAre(untangle::action_status::invoked, untangle::action_status::not_found,
+                                               untangle::action_status::invoked, untangle::action_status::invalid,
+                                               untangle::action_status::invoked, untangle::action_status::invoked));
+    EXPECT_THAT(actuator.results, testing::ElementsAre(7005, 3005, 7005, 5));
+    EXPECT_FALSE(actuator.has_action("dead"));
+  }
+}
+
+TEST(test_actuator, test_invoke_actions_ranges) {
+  std::function<int(int)> first = [](int x) { return x + 1; };
+  std::function<int(int)> second = [](int x) { return x + 2; };
+  untangle::actuator<std::function<int(int)>> actuator;
+  actuator.add("first", &first);
+  actuator.add("second", &second);
+  const auto expected = testing::ElementsAre(untangle::action_status::invoked, untangle::action_status::not_found,
+                                             untangle::action_status::invoked);
+
+  // names that are not std::string are converted, not bound to temporaries
+  const std::vector<const char*> pointers = {"second", "third", "first"};
+  EXPECT_THAT(actuator.invokeActions(pointers, 10), expected);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(12, 11));
+
+  EXPECT_THAT(actuator.invokeActions({"second", "third", "first"}, 20), expected);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(22, 21));
+
+  const std::vector<std::string_view> views = {"second", "third", "first"};
+  EXPECT_THAT(actuator.invokeActions(views, 30), expected);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(32, 31));
+
+  const std::list<std::string> list = {"second", "third", "first"};
+  EXPECT_THAT(actuator.invokeActions(list, 40), expected);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(42, 41));
+
+  const std::string array[] = {"second", "third", "first"};
+  EXPECT_THAT(actuator.invokeActions(array, 50), expected);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(52, 51));
+}
+
+TEST(test_actuator, test_hot_named_actions) {
+  constexpr int count = 200;
+  std::vector<std::function<int(int)>> actions;
+  actions.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    actions.emplace_back([i](int x) { return i + x; });
+  }
+  untangle::actuator<std::function<int(int)>> actuator;
+  for (int i = 0; i < count; ++i)
+  {
+    actuator.add("action" + std::to_string(i), &actions[i]);
+  }
+  EXPECT_EQ(actuator.hits("action5"), 0u);
+
+  // tracking does not change the actions, nor the revision of a shared table cloned by it
+  const auto revision = actuator.revision();
+  auto shared = actuator;
+  shared.track_hits();
+  EXPECT_EQ(shared.revision(), revision);
+  shared.reorganize();
+  EXPECT_EQ(shared.revision(), revision);
+  auto reorganized = shared;
+  reorganized.reorganize();
+  EXPECT_EQ(reorganized.revision(), revision);
+  actuator.track_hits();
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(actuator.invokeAction("action5", 1), untangle::action_status::invoked);
+  }
+  EXPECT_GE(actuator.hits("action5"), 10u);
+  EXPECT_FALSE(actuator.is_hot("action5"));
+  actuator.reorganize();
+  EXPECT_EQ(actuator.revision(), revision);
+  EXPECT_TRUE(actuator.is_hot("action5"));
+  EXPECT_GE(actuator.hits("action5"), 5u);
+
+  // served by the cache
+  EXPECT_EQ(actuator.invokeAction("action5", 1), untangle::action_status::invoked);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(6));
+
+  // a copy modified clones the cache with the table
+  auto copy = actuator;
+  copy.remove("action6");
+  EXPECT_TRUE(copy.is_hot("action5"));
+  EXPECT_EQ(copy.invokeAction("action5", 2), untangle::action_status::invoked);
+  EXPECT_THAT(copy.results, testing::ElementsAre(7));
+
+  // a removed action leaves the cache
+  actuator.remove("action5");
+  EXPECT_FALSE(actuator.is_hot("action5"));
+  EXPECT_EQ(actuator.invokeAction("action5", 1), untangle::action_status::not_found);
+  EXPECT_TRUE(copy.is_hot("action5"));
+
+  // the cache is resized with the names, from the hits counted before, and the counts start again
+  std::vector<std::function<int(int)>> more(2000, [](int x) { return -x; });
+  for (std::size_t i = 0; i < more.size(); ++i)
+  {
+    copy.add("more" + std::to_string(i), &more[i]);
+  }
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_EQ(copy.invokeAction("more1500", 1), untangle::action_status::invoked);
+  }
+  copy.reorganize();
+  EXPECT_TRUE(copy.is_hot("more1500"));
+  EXPECT_EQ(copy.hits("more1500"), 0u);
+  EXPECT_EQ(copy.invokeAction("more1500", 3), untangle::action_status::invoked);
+  EXPECT_THAT(copy.results, testing::ElementsAre(-3));
+
+  actuator.track_hits(false);
+  EXPECT_EQ(actuator.hits("action7"), 0u);
+  EXPECT_EQ(actuator.invokeAction("action7", 1), untangle::action_status::invoked);
+}
+
+int scaled(int factor, int x)
+{
+  return factor * x;
+}
+
+TEST(test_actuator, test_adapt) {
+  // the bound object and argument first, then the action argument
+  triangle_mock mock;
+  EXPECT_CALL(mock, test_vr_args(3, 7)).Times(1);
+  std::function<void(int)> member = untangle::adapt<std::function<void(int)>>(&shape::test_vr_args, &mock, 3);
+
+  // the result discarded, the trailing argument dropped
+  std::vector<int> seen;
+  std::function<void(int)> discarded = untangle::adapt<std::function<void(int)>>(&scaled, 2);
+  std::function<void(int)> dropped = untangle::adapt<std::function<void(int)>>([&seen]() { seen.push_back(0); });
+
+  untangle::actuator<std::function<void(int)>> actuator;
+  actuator.add(&member);
+  actuator.add(&discarded);
+  actuator.add(&dropped);
+  actuator(7);
+  EXPECT_THAT(seen, testing::ElementsAre(0));
+
+  // a prefix of the arguments, the result converted
+  std::function<long(int, const std::string&)> prefix = untangle::adapt<std::function<long(int, const std::string&)>>(&scaled, 10);
+  untangle::actuator<std::function<long(int, const std::string&)>> results;
+  results.add(&prefix);
+  results(4, "ignored");
+  EXPECT_THAT(results.results, testing::ElementsAre(40));
+
+  // as small as the lambda it replaces
+  static_assert(sizeof(untangle::adapt<std::function<void(int)>>(&scaled, 2)) <= 2 * sizeof(void*));
+}
+
+/**
+ * @brief Memory resource counting the bytes it holds.
+ */
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+  std::size_t allocated = 0;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    allocated += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    allocated -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+TEST(test_actuator, test_memory_resource) {
+  counting_resource resource;
+  std::function<int(int)> action1 = [](int x) { return x + 1; };
+  std::function<int(int)> action2 = [](int x) { return x * 2; };
+  {
+    untangle::pmr::actuator<std::function<int(int)>> actuator(&resource);
+    EXPECT_EQ(resource.allocated, 0);
+    actuator.add(&action1);
+    actuator.add(&action2, untangle::key_filter::key(1));
+    actuator.add("a named action with a long name", &action2);
+    const auto tableBytes = resource.allocated;
+    EXPECT_GT(tableBytes, 0);
+
+    actuator(10);
+    EXPECT_THAT(actuator.results, testing::ElementsAre(11, 20));
+    EXPECT_GT(resource.allocated, tableBytes);
+    EXPECT_EQ(actuator.invokeAction("a named action with a long name", 4), untangle::action_status::invoked);
+    EXPECT_THAT(actuator.results, testing::ElementsAre(8));
+
+    // a copy shares the table, and clones it in the same resource when modified
+    auto copy = actuator;
+    EXPECT_EQ(copy.get_allocator().resource(), &resource);
+    const auto sharedBytes = resource.allocated;
+    copy.remove(&action1);
+    EXPECT_GT(resource.allocated, sharedBytes);
+    copy(10);
+    EXPECT_THAT(copy.results, testing::ElementsAre(20));
+  }
+  EXPECT_EQ(resource.allocated, 0);
+
+  // all the storage released in bulk
+  std::pmr::monotonic_buffer_resource arena(4096, &resource);
+  {
+    untangle::pmr::actuator<std::function<int(int)>> actuator(&arena);
+    for (int i = 0; i < 100; ++i)
+    {
+      actuator.add(&action1);
+    }
+    actuator(1);
+    EXPECT_EQ(actuator.results.size(), 100);
+  }
+  EXPECT_GT(resource.allocated, 0);
+  arena.release();
+  EXPECT_EQ(resource.allocated, 0);
+
+  // assigned across resources: the table is cloned in the resource of the target, that outlives the source
+  counting_resource targetResource;
+  std::pmr::monotonic_buffer_resource targetArena(&targetResource);
+  untangle::pmr::actuator<std::function<int(int)>> target(&targetArena);
+  {
+    std::pmr::monotonic_buffer_resource sourceArena(&resource);
+    untangle::pmr::actuator<std::function<int(int)>> source(&sourceArena);
+    source.add(&action1);
+    source.add("named", &action2);
+    target = source;
+    EXPECT_GT(targetResource.allocated, 0);
+    EXPECT_EQ(target.revision(), source.revision());
+    untangle::pmr::actuator<std::function<int(int)>> moved(&sourceArena);
+    moved.add(&action2);
+    target = std::move(moved);
+    target = source;
+  }
+  EXPECT_EQ(target.get_allocator().resource(), &targetArena);
+  target.add(&action2);
+  target(3);
+  EXPECT_THAT(target.results, testing::ElementsAre(4, 6));
+  EXPECT_EQ(target.invokeAction("named", 5), untangle::action_status::invoked);
+  EXPECT_THAT(target.results, testing::ElementsAre(10));
+}
+
+TEST(test_actuator, test_invoke_matching) {
+  // enough actions to go through the vector and the scalar filter paths
+  constexpr int count = 37;
+  std::vector<int> calls(count, 0);
+  std::vector<std::function<void(int)>> actions;
+  actions.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    actions.emplace_back([&calls, i](int) { ++calls[i]; });
+  }
+
+  untangle::actuator<std::function<void(int)>> actuator;
+  // action 0 is not filtered, the others subscribe to key i, and every 5th one to the range [i, i + 10]
+  actuator.add(&actions[0]);
+  for (int i = 1; i < count; ++i)
+  {
+    actuator.add(&actions[i], i % 5 ? untangle::key_filter::key(i) : untangle::key_filter::range(i, i + 10));
+  }
+
+  actuator.invokeMatching(12, 0);
+  for (int i = 0; i < count; ++i)
+  {
+    const bool expected = i == 0 || i == 12 || i == 5 || i == 10;
+    EXPECT_EQ(calls[i], expected ? 1 : 0) << "action " << i;
+  }
+
+  // the call operator ignores the filters
+  std::fill(calls.begin(), calls.end(), 0);
+  actuator(0);
+  EXPECT_EQ(std::count(calls.begin(), calls.end(), 1), count);
+
+  // removing an action keeps the filters of the others
+  std::fill(calls.begin(), calls.end(), 0);
+  actuator.remove(&actions[3]);
+  actions[4] = nullptr;
+  actuator.invokeMatching(36, 0);
+  // the empty action is not removed until it is reached
+  EXPECT_EQ(actuator.actions().size(), count - 1);
+  for (int i = 0; i < count; ++i)
+  {
+    const bool expected = i == 0 || i == 36 || i == 30 || i == 35;
+    EXPECT_EQ(calls[i], expected ? 1 : 0) << "action " << i;
+  }
+  actuator(0);
+  EXPECT_EQ(actuator.actions().size(), count - 2);
+}
+
+TEST(test_actuator, test_invoke_matching_results) {
+  const auto t = std::make_shared<triangle>();
+  const auto c = std::make_shared<circle>();
+  t->height_in(1);
+  c->height_in(2);
+
+  auto action1 = untangle::bind(t, &triangle::height_out);
+  auto action2 = untangle::bind(c, &circle::height_out);
+  untangle::actuator<decltype(action1)> actuator;
+  actuator.add(&action1, untangle::key_filter::key(1));
+  actuator.add(&action2, untangle::key_filter::key(2));
+
+  actuator.invokeMatching(2);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(2));
+  actuator.invokeMatching(3);
+  EXPECT_TRUE(actuator.results.empty());
+}
+
+TEST(test_actuator, test_invoke_matching_several_actions) {
+  std::vector<std::string> received;
+  std::function<void(std::string)> action1 = [&received](std::string text) { received.push_back(text); };
+  std::function<void(std::string)> action2 = [&received](std::string text) { received.push_back(text); };
+  untangle::actuator<std::function<void(std::string)>> actuator;
+  actuator.add(&action1, untangle::key_filter::key(1));
+  actuator.add(&action2, untangle::key_filter::range(0, 2));
+
+  // every matching action receives the arguments, not what the previous one left of them
+  actuator.invokeMatching(1, std::string("world"));
+  EXPECT_THAT(received, testing::ElementsAre("world", "world"));
+}
+
+TEST(test_actuator, test_bulk_add_remove) {
+  constexpr int count = 1000;
+  std::vector<int> calls(count, 0);
+  std::vector<std::function<void(int)>> actions;
+  actions.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    actions.emplace_back([&calls, i](int) { ++calls[i]; });
+  }
+
+  // positional actions
+  std::vector<std::function<void(int)>*> pointers;
+  for (auto& action : actions)
+  {
+    pointers.push_back(&action);
+  }
+  untangle::actuator<std::function<void(int)>> actuator;
+  actuator.add(pointers.front());
+  const auto revision = actuator.revision();
+  const auto* storage = &actuator.actions();
+  // reserving does not change the actions, nor the revision
+  actuator.reserve(count);
+  EXPECT_EQ(actuator.revision(), revision);
+  EXPECT_EQ(&actuator.actions(), storage);
+  actuator.add_range(pointers.begin() + 1, pointers.end());
+  EXPECT_EQ(actuator.actions().size(), count);
+
+  // named actions, from an unsorted range with a duplicate name
+  std::vector<std::pair<std::string, std::function<void(int)>*>> named;
+  for (int i = count - 1; i >= 0; --i)
+  {
+    named.emplace_back("action" + std::to_string(i), &actions[i]);
+  }
+  named.emplace_back("action7", &actions[0]);
+  actuator.add("action0", &actions[1]);
+  actuator.add_range(named.begin(), named.end());
+  EXPECT_EQ(actuator.mapActions().size(), count);
+  EXPECT_TRUE(std::is_sorted(actuator.mapActions().begin(), actuator.mapActions().end()));
+
+  // names already present, or repeated in the range, keep their first action
+  actuator.invokeAction("action0", 0);
+  actuator.invokeAction("action7", 0);
+  EXPECT_EQ(calls[1], 1);
+  EXPECT_EQ(calls[7], 1);
+  EXPECT_EQ(calls[0], 0);
+
+  // bulk removal
+  EXPECT_EQ(actuator.remove_if([&actions](const auto* action) { return (action - actions.data()) % 2 == 0; }),
+            count / 2);
+  EXPECT_EQ(actuator.remove_named_if([](const std::string& name, const auto*) { return name.size() > 8; }),
+            count - 100);
+  EXPECT_EQ(actuator.actions().size(), count / 2);
+  EXPECT_EQ(actuator.mapActions().size(), 100);
+  EXPECT_EQ(actuator.remove_if([](const auto*) { return false; }), 0);
+
+  std::fill(calls.begin(), calls.end(), 0);
+  actuator(0);
+  EXPECT_EQ(std::count(calls.begin(), calls.end(), 1), count / 2);
+  EXPECT_EQ(calls[0], 0);
+  EXPECT_EQ(calls[1], 1);
+}
+
+TEST(test_actuator, test_bulk_add_sorted_names) {
+  std::vector<std::function<int(int)>> actions;
+  for (int i = 0; i < 4; ++i)
+  {
+    actions.emplace_back([i](int x) { return i + x; });
+  }
+  counting_resource resource;
+  untangle::pmr::actuator<std::function<int(int)>> actuator(&resource);
+
+  // a sorted range merged with the names already present, in the actuator resource
+  actuator.add("b", &actions[0]);
+  const std::pair<const char*, std::function<int(int)>*> sorted[] = {{"a", &actions[1]}, {"b", &actions[2]}, {"c", &actions[3]}};
+  const auto allocated = resource.allocated;
+  actuator.add_range(std::begin(sorted), std::end(sorted));
+  EXPECT_GT(resource.allocated, allocated);
+  EXPECT_EQ(actuator.mapActions().size(), 3);
+  EXPECT_EQ(actuator.invokeAction("a", 10), untangle::action_status::invoked);
+  EXPECT_EQ(actuator.invokeAction("b", 10), untangle::action_status::invoked);
+  EXPECT_EQ(actuator.invokeAction("c", 10), untangle::action_status::invoked);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(13));
+  actuator.invokeActions({"a", "b"}, 10);
+  EXPECT_THAT(actuator.results, testing::ElementsAre(11, 10));
+}
+
 TEST(test_actuator, test_extract_results) {
   //! [test_extract_results]
   const auto t = std::make_shared<triangle>();
@@ -0,0 +1,119 @@
+/**
+ * @brief Test the timer wheel scheduling actuator emissions.
+ *
+ * @file actuator_timer_test.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#include <actuator_timer.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace untangle::test {
+
+using namespace std::chrono_literals;
+
+TEST(test_actuator_timer, test_one_shot_expiry) {
+  const auto start = untangle::timer_wheel::clock::now();
+  untangle::timer_wheel wheel(1ms, start);
+
+  // delays across all the wheel levels, fired exactly on their tick
+  const std::vector<std::uint64_t> delays = {1, 5, 255, 256, 300, 65535, 65536, 70000, 16777216 + 3};
+  std::vector<std::uint64_t> fired;
+  for (const auto delay : delays)
+  {
+    wheel.schedule(std::chrono::milliseconds(delay), [&wheel, &fired, delay]()
+    {
+      EXPECT_EQ(wheel.now(), delay);
+      fired.push_back(delay);
+    });
+  }
+  EXPECT_EQ(wheel.size(), delays.size());
+
+  EXPECT_EQ(wheel.advance(start), 0);
+  std::size_t total = 0;
+  // advance in uneven steps
+  for (std::uint64_t tick = 0; tick <= 16777216 + 10; tick += 997)
+  {
+    total += wheel.advance(start + std::chrono::milliseconds(tick));
+  }
+  total += wheel.advance(start + std::chrono::milliseconds(16777216 + 10));
+  EXPECT_EQ(total, delays.size());
+  EXPECT_EQ(fired, delays);
+  EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST(test_actuator_timer, test_expiry_across_top_carry) {
+  const untangle::timer_wheel::clock::time_point start{};
+  untangle::timer_wheel wheel(1us, start);
+
+  // just below 2^32 ticks: the expiries carry past the top level bits
+  const std::uint64_t base = (std::uint64_t(1) << 32) - 100;
+  wheel.advance(start + std::chrono::microseconds(base));
+  EXPECT_EQ(wheel.now(), base);
+
+  std::vector<std::uint64_t> fired;
+  int periodic = 0;
+  wheel.schedule(200us, [&wheel, &fired]() { fired.push_back(wheel.now()); });
+  wheel.schedule(70000us, [&wheel, &fired]() { fired.push_back(wheel.now()); });
+  wheel.schedule_every(50us, [&periodic]() { ++periodic; });
+  for (std::uint64_t tick = base; tick <= base + 70000; tick += 37)
+  {
+    wheel.advance(start + std::chrono::microseconds(tick));
+  }
+  wheel.advance(start + std::chrono::microseconds(base + 70000));
+  EXPECT_THAT(fired, testing::ElementsAre(base + 200, base + 70000));
+  EXPECT_EQ(periodic, 1400);
+  EXPECT_EQ(wheel.size(), 1);
+}
+
+TEST(test_actuator_timer, test_periodic_and_cancel) {
+  const auto start = untangle::timer_wheel::clock::now();
+  untangle::timer_wheel wheel(1ms, start);
+
+  int periodic = 0;
+  int cancelled = 0;
+  const auto periodicId = wheel.schedule_every(10ms, [&periodic]() { ++periodic; });
+  const auto cancelledId = wheel.schedule(20ms, [&cancelled]() { ++cancelled; });
+  EXPECT_TRUE(wheel.cancel(cancelledId));
+  EXPECT_FALSE(wheel.cancel(cancelledId));
+
+  wheel.advance(start + 95ms);
+  EXPECT_EQ(periodic, 9);
+  EXPECT_EQ(cancelled, 0);
+  EXPECT_EQ(wheel.size(), 1);
+
+  EXPECT_TRUE(wheel.cancel(periodicId));
+  wheel.advance(start + 200ms);
+  EXPECT_EQ(periodic, 9);
+  EXPECT_EQ(wheel.size(), 0);
+
+  // timers of the same batch cancelling themselves and each other: only the first one fired runs
+  int fired = 0;
+  untangle::timer_wheel::timer_id first = 0;
+  untangle::timer_wheel::timer_id second = 0;
+  first = wheel.schedule_every(5ms, [&]() { ++fired; wheel.cancel(first); wheel.cancel(second); });
+  second = wheel.schedule_every(5ms, [&]() { ++fired; wheel.cancel(first); wheel.cancel(second); });
+  wheel.advance(start + 300ms);
+  EXPECT_EQ(fired, 1);
+  EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST(test_actuator_timer, test_actuator_emissions) {
+  const auto start = untangle::timer_wheel::clock::now();
+  untangle::timer_wheel wheel(1ms, start);
+
+  std::vector<int> angles;
+  std::function<void(int)> rotate = [&angles](int angle) { angles.push_back(angle); };
+  auto actuator_rotate = untangle::connect(rotate);
+  actuator_rotate.add("rotate", &rotate);
+
+  wheel.emit_after(3ms, actuator_rotate, 10);
+  wheel.emit_every(2ms, actuator_rotate, 20);
+  wheel.invoke_action_after(5ms, actuator_rotate, "rotate", 30);
+  wheel.advance(start + 5ms);
+  EXPECT_THAT(angles, testing::ElementsAre(20, 10, 20, 30));
+}
+
+} // namespace untangle::test
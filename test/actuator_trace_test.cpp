@@ -0,0 +1,107 @@
+/**
+ * @brief Test the actuator dispatch tracing.
+ *
+ * @file actuator_trace_test.cpp
+ * @author Nicolae Popescu
+ * @date 2025
+ */
+#define UNTANGLE_TRACE
+#include <actuator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace untangle::test {
+
+TEST(test_actuator_trace, test_nested_emissions) {
+  trace::clear();
+
+  int total = 0;
+  untangle::actuator<std::function<void(int)>> inner;
+  std::function<void(int)> add = [&total](int value) { total += value; };
+  inner.add(&add);
+
+  untangle::actuator<std::function<void(int)>> outer;
+  std::function<void(int)> forward = [&inner](int value) { inner(value); };
+  outer.add(&forward);
+  outer.add("forward", &forward);
+
+  outer(1);
+  outer.invokeAction("forward", 2);
+  EXPECT_EQ(total, 3);
+
+  // per emission: outer emission, forward action, inner emission, add action
+  EXPECT_EQ(trace::size(), 8);
+
+  const std::string path = testing::TempDir() + "actuator_trace_test.json";
+  ASSERT_TRUE(trace::dump(path));
+  std::ifstream in(path);
+  std::stringstream json;
+  json << in.rdbuf();
+  EXPECT_EQ(json.str().rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0);
+  EXPECT_NE(json.str().find("\"name\":\"forward\",\"cat\":\"emission\""), std::string::npos);
+  EXPECT_NE(json.str().find("\"depth\":3"), std::string::npos);
+  EXPECT_EQ(json.str().find("\"depth\":4"), std::string::npos);
+  std::remove(path.c_str());
+}
+
+TEST(test_actuator_trace, test_per_thread_buffers) {
+  trace::clear();
+
+  std::atomic<int> total{0};
+  untangle::actuator<std::function<void(int)>> actuator;
+  std::function<void(int)> add = [&total](int value) { total += value; };
+  actuator.add(&add);
+
+  std::thread other([actuator]() mutable { actuator(1); });
+  other.join();
+  actuator(2);
+
+  EXPECT_EQ(total, 3);
+  EXPECT_EQ(trace::size(), 4);
+}
+
+TEST(test_actuator_trace, test_finished_threads_released) {
+  trace::clear();
+  const auto registered = trace::buffers();
+
+  untangle::actuator<std::function<void(int)>> actuator;
+  std::function<void(int)> nothing = [](int) {};
+  actuator.add(&nothing);
+
+  // the buffers of the finished threads are kept until dumped
+  for (int i = 0; i < 8; ++i)
+  {
+    std::thread([actuator, i]() mutable { actuator(i); }).join();
+  }
+  EXPECT_EQ(trace::buffers(), registered + 8);
+  EXPECT_EQ(trace::size(), 16);
+
+  const std::string path = testing::TempDir() + "actuator_trace_threads.json";
+  ASSERT_TRUE(trace::dump(path));
+  std::remove(path.c_str());
+  EXPECT_EQ(trace::buffers(), registered);
+  EXPECT_EQ(trace::size(), 0);
+
+  // or cleared, while the threads emitting keep theirs
+  for (int i = 0; i < 3 * UNTANGLE_TRACE_THREADS; ++i)
+  {
+    std::thread([actuator]() mutable { actuator(0); }).join();
+    if (i % 8 == 7)
+    {
+      trace::clear();
+      EXPECT_EQ(trace::buffers(), registered);
+    }
+  }
+  trace::clear();
+  EXPECT_EQ(trace::buffers(), registered);
+  actuator(0);
+  EXPECT_EQ(trace::size(), 2);
+}
+
+} // namespace untangle::test